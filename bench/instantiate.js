@@ -0,0 +1,36 @@
+/**
+ * Instantiation benchmark for ssm2044~
+ *
+ * Load in a patcher as [js instantiate.js] and send "bang" (1000 objects)
+ * or "run <count>". Creates the objects in the host patcher, removes them
+ * again and reports milliseconds per 1000 instances (creation only).
+ *
+ * Outlet: milliseconds per 1000 objects
+ */
+
+autowatch = 1;
+inlets = 1;
+outlets = 1;
+
+function bang() {
+    run(1000);
+}
+
+function run(count) {
+    count = Math.max(1, count | 0);
+    var objects = [];
+    
+    var start = new Date().getTime();
+    for (var i = 0; i < count; i++) {
+        objects.push(this.patcher.newdefault(20, 20, "ssm2044~", 1000, 0.5, 1));
+    }
+    var elapsed = new Date().getTime() - start;
+    
+    for (var j = 0; j < objects.length; j++) {
+        this.patcher.remove(objects[j]);
+    }
+    
+    var per_thousand = elapsed * 1000.0 / count;
+    post("ssm2044~: " + count + " instances in " + elapsed + " ms (" + per_thousand.toFixed(2) + " ms per 1000)\n");
+    outlet(0, per_thousand);
+}
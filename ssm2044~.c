@@ -25,9 +25,11 @@
  * 
  * Inlets:
  *   1. Audio input (signal) - input signal to be filtered
- *   2. Cutoff frequency (signal/float, 20-20000 Hz) - filter cutoff frequency
+ *   2. Cutoff frequency (signal/float, 20-20000 Hz, or 0-10 V with @cvcurve) - filter cutoff
  *   3. Resonance (signal/float, 0.0-4.0) - filter resonance/Q factor
  *   4. Input gain (signal/float, 0.0-4.0) - input gain with musical saturation
+ *   5. Response morph (signal/float, 0.0-1.0) - LP24 -> LP12 -> BP -> HP
+ *   6. Linear FM (signal/float, Hz) - deviation added after the cutoff mapping
  * 
  * Outlets:
  *   1. Filtered output (signal, -1.0 to 1.0) - filtered audio signal
@@ -36,25 +38,306 @@
 #include "ext.h"
 #include "ext_obex.h"
 #include "z_dsp.h"
+#include "ext_atomic.h"
+#include "ext_systime.h"
+#include "ext_systhread.h"
 #include <math.h>
+#include <string.h>
+
+#ifdef MAC_VERSION
+#include <Accelerate/Accelerate.h>  // vForce vvtanh for the input-conditioning pass
+#endif
 
 #define PI 3.14159265358979323846
 #define DENORMAL_THRESHOLD 1e-15
 
-// Filter constants
-#define RESONANCE_SCALE 4.0     // Resonance feedback scaling
+// Filter constants (the SSM2044 voicing; MAX_RESONANCE is also the inlet range for every model)
+#define RESONANCE_SCALE 1.25    // Resonance -> k: oscillation (k ~4.3 at 1 kHz) starts near 3.5
 #define MAX_RESONANCE 4.0       // Maximum resonance value
 
 // Character constants
 #define INPUT_DRIVE 1.5         // Input saturation drive (subtle)
 #define FEEDBACK_DRIVE 2.0      // Feedback saturation drive (moderate)
 
+// Vintage voicings (@model), in enum order:
+//   X(name, input drive, feedback drive, resonance scale, max resonance)
+// Every model gets its own copy of each per-sample kernel with the feedback drive folded
+// in (SSM2044_DEFINE_KERNELS); the other values are read once per block or per resonance change.
+#define SSM2044_MODELS(X) \
+    X(ssm2044,  INPUT_DRIVE, FEEDBACK_DRIVE, RESONANCE_SCALE, MAX_RESONANCE) \
+    X(polysix,  1.2,         1.6,            1.5,             4.0) \
+    X(monopoly, 1.8,         2.2,            1.65,            4.0) \
+    X(proone,   2.2,         2.5,            2.1,             4.0)
+
+enum {
+    MODEL_SSM2044 = 0,          // Generic chip voicing (the original constants)
+    MODEL_POLYSIX,              // Korg Polysix: gentle drive, resonance stops short of screaming
+    MODEL_MONOPOLY,             // Korg Mono/Poly: hotter, resonance comes in earlier
+    MODEL_PROONE,               // Sequential Pro-One: hot mixer into the filter, wider resonance
+    MODELS
+};
+
+// Per-sample kernels generated for every model
+enum {
+    KERNEL_CASCADE = 0,         // ssm2044_cascade_kernel
+    KERNEL_OTA,                 // ssm2044_ota_kernel (cascade with @stagesat)
+    KERNEL_WDF,                 // ssm2044_wdf_kernel
+    KERNEL_DK,                  // ssm2044_dk_kernel
+    KERNEL_CASCADE_TABLE,       // ssm2044_cascade_kernel with table feedback (@deterministic)
+    KERNELS
+};
+
+#if defined(_MSC_VER)
+#define SSM2044_KERNEL static __forceinline
+#else
+#define SSM2044_KERNEL static inline __attribute__((always_inline))
+#endif
+
+// Resonance compensation modes (@compensation)
+enum {
+    COMPENSATION_OFF = 0,       // Raw output, passband drops as resonance rises
+    COMPENSATION_MUSICAL,       // 1 + resonance * 0.5 (partial, keeps the resonant peak prominent)
+    COMPENSATION_FULL           // 1 + k (restores the DC/passband gain of the linear filter)
+};
+
+// Self-oscillation stabilizer (@stabilize)
+#define SELF_OSC_K 4.0          // Feedback gain where the cascade starts to self-oscillate
+#define STABILIZER_TIME 0.2     // Seconds for the control loop to close most of the error
+#define STABILIZER_RELEASE 0.1  // Peak follower release time in seconds
+
+// Self-oscillation pitch calibration (@tune)
+#define TUNE_TABLE_SIZE 512     // Intervals from 0 Hz to the cutoff limit (0.45 * processing rate)
+#define TUNE_TABLE_SLOTS 16     // Distinct processing rates with a shared table
+
+// Self-oscillation excitation (kick message / @kickmode)
+enum {
+    KICK_OFF = 0,               // No automatic kick (the kick message still uses an impulse)
+    KICK_IMPULSE,               // One-sample excitation added to stage 1
+    KICK_STEP                   // DC step on the stage-1 input, held while above the threshold
+};
+
+// Input saturation curves (@saturation)
+enum {
+    SATURATION_SYMMETRIC = 0,   // tanh (odd harmonics only)
+    SATURATION_ASYMMETRIC       // tanh(u) + 0.05 * tanh(u/2)^2 (adds even harmonics)
+};
+#define SATURATION_TABLE_SIZE 2048  // Intervals across the tabulated range
+#define SATURATION_TABLE_RANGE 8.0  // Tabulated for |drive * input| <= range
+
+// Output conditioning (@dcblock / @limit)
+#define DC_BLOCK_FREQ 10.0      // DC blocker corner frequency in Hz
+#define LIMIT_KNEE 1.5          // Input level where the soft limiter reaches +-1.0
+
+// Bypass (@bypass / @bypassmode)
+#define BYPASS_FADE_TIME 0.005  // Seconds for the wet/dry crossfade
+#define BYPASS_DECAY_TIME 0.02  // Time constant for decaying filter state while bypassed
+enum {
+    BYPASS_FREEZE = 0,          // Keep filter state as it was; resumes ringing on return
+    BYPASS_DECAY                // Let filter state die away; resumes from silence
+};
+
+// Filter engines (@engine)
+enum {
+    ENGINE_CASCADE = 0,         // Idealized backward-Euler cascade (ssm2044_cascade_kernel)
+    ENGINE_WDF,                 // Wave digital model of the OTA/capacitor stages (ssm2044_wdf_kernel)
+    ENGINE_DK                   // Nodal DK state-space model with a saturating input OTA (ssm2044_dk_kernel)
+};
+#define WDF_ROOT_ITERATIONS 4   // Fixed Newton steps for the feedback root (cost doesn't depend on signal)
+#define DK_TABLE_SIZE 256       // Discretized matrix sets from 0 to 0.45 * processing rate
+#define DK_NEWTON_ITERATIONS 3  // Fixed 2x2 Newton steps, warm-started from the previous sample
+#define OTA_DRIVE 1.0           // Differential input drive of a saturating OTA stage
+#define DK_OTA_EASE 1.0         // DK stage-1 OTA drive is OTA_DRIVE / (1 + DK_OTA_EASE * k)
+#define TANH_TABLE_SIZE 512     // Intervals of the shared tanh table (8 KB with slopes)
+#define TANH_TABLE_RANGE 8.0    // Tabulated for |u| <= range, +-1 outside
+
+// Per-stage OTA saturation (@stagesat): stage outputs are s + g * tanh(d * (in - s)) / d,
+// read from the shared tanh table, which stays in L1 across the four stages
+
+// Cutoff CV response (@cvcurve): the cutoff inlet takes 0-10 V and a dense table maps it
+// to a corner frequency. Measured curves for specific voice cards go in as further rows.
+enum {
+    CV_CURVE_OFF = 0,           // Cutoff inlet in Hz
+    CV_CURVE_1VOCT,             // Ideal 1 V/oct from C0 at 0 V
+    CV_CURVES
+};
+#define CV_BREAKPOINTS 11       // Response points per curve, one per volt from 0 to 10 V
+#define CV_TABLE_SIZE 128       // Dense table intervals over 0-10 V (under a cent of error)
+#define CV_TABLE_VOLTS 10.0
+
+// Coefficient update interval, picked per block from how fast the cutoff moves
+#define COEFF_INTERVAL_MAX 16   // Longest interval (samples) between exact cutoff coefficients
+#define COEFF_MOTION_LIMIT 0.01 // Largest relative cutoff change allowed across one interval
+
+// CPU watchdog (@budget): quality tiers shed while perform runs over budget, cheapest last.
+// Each tier includes the savings of the ones above it.
+enum {
+    QUALITY_FULL = 0,           // Everything as configured
+    QUALITY_DECIMATED,          // Cutoff coefficients every COEFF_INTERVAL_MAX samples, no FM pre-pass
+    QUALITY_BASE_RATE,          // Oversampling off
+    QUALITY_CASCADE,            // Plain cascade kernel: no per-stage tanh, no WDF/DK solver
+    QUALITY_TIERS
+};
+#define WATCHDOG_SMOOTHING 0.25     // Load follower coefficient per block
+#define WATCHDOG_OVER_BLOCKS 4      // Consecutive over-budget blocks before stepping down
+#define WATCHDOG_HEADROOM 0.5       // Step back up only while below this share of the budget
+#define WATCHDOG_RECOVER_TIME 1.0   // Seconds of headroom before stepping up
+#define WATCHDOG_RECOVER_MAX 16.0   // Longest wait after a step up that didn't fit
+#define WATCHDOG_DECLICK_TIME 0.002 // Seconds to fade out the step when the oversampling factor changes
+
+// Class-wide load shedding (totalbudget message): a clock sums every instance's published
+// load and sets per-instance shed tiers, lowest @priority first
+#define COORDINATOR_INTERVAL 100.0  // Milliseconds between coordinator passes
+#define COORDINATOR_STALE 500.0     // Instances that haven't run for this long (ms) cost nothing
+#define COORDINATOR_STEP_SAVING 0.5 // Assumed share of an instance's load one tier saves
+#define COORDINATOR_HEADROOM 0.6    // Restore a tier only while the total is below this share
+#define PRIORITY_MAX 10             // @priority range is 0 (shed first) to PRIORITY_MAX
+
+// Cost prediction (cost message / @cost): per-component timings measured once per machine
+#define CALIBRATION_FRAMES 16384    // Samples per timed component
+#define CALIBRATION_RUNS 3          // Best of this many runs, to skip interruptions
+
+// Oversampling constants
+#define MAX_OVERSAMPLE 4        // Highest oversampling factor accepted by the attribute
+#define DECIMATOR_TAPS_PER_FACTOR 8 // Decimation FIR length per unit of oversampling
+#define MAX_DECIMATOR_TAPS (MAX_OVERSAMPLE * DECIMATOR_TAPS_PER_FACTOR)
+#define SCRATCH_SLOTS 32        // Blocks that can hold oversampling scratch at the same moment
+#define SCRATCH_ROWS (MAX_OVERSAMPLE + 1) // Per slot: the oversampled block plus one coefficient row
+
+// Multimode tap outlets (created with @taps 1), in outlet order after the main LP24
+enum {
+    TAP_LP6 = 0,                // 1-pole low-pass (stage 1)
+    TAP_LP12,                   // 2-pole low-pass (stage 2)
+    TAP_LP18,                   // 3-pole low-pass (stage 3)
+    TAP_BP,                     // 2-pole band-pass: 2 * (stage1 - stage2)
+    TAP_HP,                     // 2-pole high-pass: input - 2 * stage1 + stage2
+    TAP_OUTLETS
+};
+
+// Response morph (inlet 5): LP24 -> LP12 -> BP -> HP as weights over
+// {stage input, stage1, stage2, stage3, stage4}
+#define MORPH_WEIGHTS 5
+#define MORPH_TABLE_SIZE 96     // Rows per full sweep (multiple of 3 so keyframes land on rows)
+
+#ifdef WIN_VERSION
+#define SSM2044_THREAD_LOCAL __declspec(thread)
+#else
+#define SSM2044_THREAD_LOCAL __thread
+#endif
+
+// Realtime-safety checking: configure with -DSSM2044_RT_CHECK=ON to abort when anything
+// allocates or frees on the process heap while ssm2044_perform64 is running on the current
+// thread: this file, the Max SDK (sysmem_*), libc or libm. The allocator is interposed for
+// the whole process, and the thread-local flag limits the check to this object's perform.
+// Rule: every buffer is prepared in dsp64 or an attribute setter, never in perform.
+#ifndef SSM2044_RT_CHECK
+#define SSM2044_RT_CHECK 0
+#endif
+
+#if SSM2044_RT_CHECK
+static SSM2044_THREAD_LOCAL long ssm2044_in_perform = 0;
+#define SSM2044_PERFORM_BEGIN() (ssm2044_in_perform = 1)
+#define SSM2044_PERFORM_END() (ssm2044_in_perform = 0)
+void ssm2044_rt_check(const char *call);
+void ssm2044_rt_install(void);
+#else
+#define SSM2044_PERFORM_BEGIN() ((void)0)
+#define SSM2044_PERFORM_END() ((void)0)
+#endif
+
+// Decimation FIR history (mirrored ring so the kernel reads contiguous memory)
+typedef struct _ssm2044_decimator {
+    double history[2 * MAX_DECIMATOR_TAPS];
+    long position;
+} t_ssm2044_decimator;
+
+// One-pole DC blocker state (one per outlet)
+typedef struct _ssm2044_dcblocker {
+    double x1;                  // Previous input
+    double y1;                  // Previous output
+} t_ssm2044_dcblocker;
+
+// Wave digital filter engine. Each SSM2044 stage is an OTA (a transconductance 1/gm, so a
+// resistive source) charging a capacitor, buffered into the next stage. With port resistances
+// R = 1/gm and Rc = T/2C the two-port adaptor reflects with gamma = Rc / (R + Rc), which is the
+// prewarped integrator gain g. The feedback tanh is the only nonlinear element and sits at the root.
+typedef struct _ssm2044_wdf {
+    double state[4];            // Reflected waves of the four capacitors (one-sample delays)
+    double g;                   // Key: integrator gain the adaptors were derived for (-1 = stale)
+    double k;                   // Key: feedback gain the root was derived for
+    double gamma;               // Adaptor reflection coefficient
+    double leak;                // 1 - gamma (capacitor share of each stage output)
+    double loop_gain;           // gamma^4: instantaneous gain from the root to the 4th capacitor
+    double root_c;              // loop_gain * k: slope of the tanh term in the root equation
+} t_ssm2044_wdf;
+
+// Nodal DK engine. States are the four capacitor voltages; the nonlinear elements are the
+// stage-1 OTA (which sees input minus feedback, the largest swing in the chip) and the
+// feedback tanh. Trapezoidal discretization with prewarping gives
+//   p = A x[n-1] + c i1[n-1],  x[n] = p + c i1[n]
+// and A, c depend only on cutoff / processing rate, so one shared table serves every instance.
+typedef struct _ssm2044_dk_matrices {
+    double a[4][4];             // Discrete state matrix (lower triangular)
+    double c[4];                // Discrete gain of the stage-1 OTA current into each state
+} t_ssm2044_dk_matrices;
+
+typedef struct _ssm2044_dk {
+    double state[4];            // Capacitor voltages
+    double ota_prev;            // Stage-1 OTA current of the previous sample
+    double v[2];                // Nonlinear port voltages (OTA input, feedback node): Newton warm start
+    double position;            // Requested table position (set with the coefficients)
+    double position_key;        // Position the working matrices were interpolated for (-1 = stale)
+    t_ssm2044_dk_matrices m;    // Working matrices
+} t_ssm2044_dk;
+
+// Per-rate derived data, rebuilt only when the DSP configuration actually changes
+typedef struct _ssm2044_rate_cache {
+    double samplerate;          // Key: host sample rate (0 = not built)
+    long maxvectorsize;         // Key: host vector size
+    double filter_sr[MAX_OVERSAMPLE + 1];     // Processing rate for every factor
+    double filter_sr_inv[MAX_OVERSAMPLE + 1]; // Reciprocals of the above
+    const double *tune_table[MAX_OVERSAMPLE + 1]; // Shared pitch calibration (NULL = use tan)
+    double tune_index_scale[MAX_OVERSAMPLE + 1];  // Table intervals per Hz
+    double dc_coeff;            // DC blocker pole at the host rate
+    double bypass_step;         // Crossfade increment per sample
+    double bypass_decay;        // State decay per vector while fully bypassed
+} t_ssm2044_rate_cache;
+
+// Cutoff -> integrator gain table for one processing rate, shared by all instances
+typedef struct _ssm2044_tune_table {
+    double filter_sr;           // Processing rate the table was derived for (0 = never used)
+    long refs;                  // Rate caches holding the table; 0 = may be rebuilt for another rate
+    double g[TUNE_TABLE_SIZE + 1];
+} t_ssm2044_tune_table;
+
+// Measured per-component costs in ns, combined by ssm2044_predict_cost
+typedef struct _ssm2044_costs {
+    long ready;                 // 1 once calibrated
+    double kernel[KERNELS];     // Per filter sample (at the processing rate)
+    double condition;           // Input gain and tanh saturation, per processing-rate sample
+    double condition_asymmetric; // The same with @saturation asymmetric
+    double decimate[MAX_OVERSAMPLE + 1]; // One decimator, per host sample at each factor
+    double coefficient;         // One exact cutoff coefficient (tan prewarp)
+    double morph;               // Morph weights and mix, per processing-rate sample
+    double output;              // Output gain, denormal fix and store, per host sample and outlet
+    double dcblock;             // @dcblock, per host sample and outlet
+    double limit;               // @limit, per host sample and outlet
+    double taps;                // Tap outputs from the stage states, per processing-rate sample
+} t_ssm2044_costs;
+
+// Voicing values that are not folded into the kernels
+typedef struct _ssm2044_voicing {
+    double input_drive;         // Block pre-pass drive
+    double resonance_scale;     // Resonance -> k, applied on resonance changes
+    double max_resonance;       // Per-block resonance clamp
+} t_ssm2044_voicing;
+
 typedef struct _ssm2044 {
     t_pxobject ob;              // MSP object header
     
     // Core filter state (ZDF topology)
     double state1, state2, state3, state4;  // 4-pole filter states
     double feedback_sample;     // Feedback sample for ZDF
+    double stage_input;         // Input to stage 1 (after feedback), used by HP/BP taps
     
     // Sample rate
     double sr;                  // Sample rate
@@ -69,14 +352,112 @@ typedef struct _ssm2044 {
     short cutoff_has_signal;    // 1 if cutoff inlet has signal connection
     short resonance_has_signal; // 1 if resonance inlet has signal connection
     short gain_has_signal;      // 1 if gain inlet has signal connection
+    short morph_has_signal;     // 1 if morph inlet has signal connection
+    short fm_has_signal;        // 1 if linear FM inlet has signal connection
+    
+    // Response morph (0 = LP24, 1/3 = LP12, 2/3 = BP, 1 = HP)
+    double morph_float;         // Morph position when no signal connected
+    
+    // Linear FM (Hz added after the exponential/CV cutoff mapping)
+    double fm_float;            // Constant deviation when no signal connected
     
-    // Filter coefficients (computed per sample for stability)
+    // Filter coefficients (exact at update points, ramped in between)
     double g;                   // Integrator gain (cutoff-dependent)
     double k;                   // Resonance feedback gain
+    double coeff_resonance;     // Resonance that k and output_gain were computed for
+    double cutoff_prev;         // Last raw cutoff sample of the previous block (motion estimate)
+    long coeff_interval;        // Interval the last block used (cost prediction)
+    
+    // Self-oscillation stabilizer (per-block loop trimming k above SELF_OSC_K)
+    long stabilize;             // 1 = hold self-oscillation at stabilize_level
+    double stabilize_level;     // Target peak level of the feedback node
+    double stabilize_trim;      // 0-1 share of k above SELF_OSC_K currently allowed
+    double stabilize_env;       // Peak follower of the last stage
+    
+    // Excitation kick for deterministic self-oscillation start
+    long kick_mode;             // KICK_OFF / _IMPULSE / _STEP on threshold crossings
+    double kick_amount;         // Excitation size
+    double kick_step;           // DC added to the stage-1 input by a Step kick (0 = none)
+    t_int32_atomic kick_pending; // Kick shape waiting for the audio thread (0 = none)
+    double kick_prev_k;         // Nominal k of the previous resonance update
+    
+    // Resonance compensation (recomputed with k, applied in the output write)
+    long compensation;          // COMPENSATION_OFF / _MUSICAL / _FULL
+    double output_gain;         // Current compensation gain
+    
+    // Processing rate seen by the filter (sr * active oversampling factor)
+    double filter_sr;
+    double filter_sr_inv;
+    t_ssm2044_rate_cache rate;  // Cached per-rate data keyed on the DSP configuration
+    
+    // Pitch calibration for the active processing rate (copied from the rate cache per block)
+    long tune;                  // 1 = resonant peak / self-oscillation lands on the cutoff
+    long tune_warned;           // Set the first time a rate finds no free tune table slot
+    const double *tune_table;
+    double tune_index_scale;
+    
+    // Oversampling support (block scratch is borrowed from the shared pool)
+    long oversample_factor;     // 1-4x oversampling
+    long scratch_warned;        // Set by perform the first time a block finds no scratch slot
+    void *scratch_qelem;        // Posts that warning from the main thread
+    long active_factor;         // Factor the last block actually ran at
+    double output_history[2];   // Last two filtered samples, extrapolated across a factor change
+    double declick;             // Offset still being faded out after a factor change
+    double declick_step;        // Fade decrement per sample
+    long maxvectorsize;         // Vector size from the last dsp64 call (0 = not compiled)
+    double upsample_prev;       // Last input sample for the interpolating upsampler
+    t_ssm2044_decimator decimator; // Per-instance decimation history
+    
+    // Filter engine
+    long engine;                // ENGINE_CASCADE / ENGINE_WDF / ENGINE_DK
+    long active_engine;         // Engine the last block ran (the cascade while the watchdog sheds)
+    t_ssm2044_wdf wdf;          // Wave digital engine state and adaptors
+    t_ssm2044_dk dk;            // DK engine state and interpolated matrices
+    long stage_saturation;      // 1 = cascade saturates in every OTA stage
+    
+    // Vintage voicing
+    long model;                 // MODEL_SSM2044 / _POLYSIX / _MONOPOLY / _PROONE
+    
+    // Cutoff CV response
+    long cv_curve;              // CV_CURVE_OFF (Hz) or the curve that maps volts
+    
+    // CPU watchdog (tiers are changed after a block, read once at the top of the next)
+    double budget;              // Percent of real time this instance may use (0 = off)
+    long quality;               // QUALITY_FULL .. QUALITY_CASCADE
+    double load_share;          // Smoothed block time / block duration (published for the coordinator)
+    double load_time;           // systimer_gettime() at the end of the last timed block
+    long watchdog_over;         // Consecutive over-budget blocks
+    double watchdog_calm;       // Seconds spent below WATCHDOG_HEADROOM
+    double watchdog_recover;    // Seconds of headroom required before the next step up
+    long watchdog_stepped_up;   // 1 = the last tier change was a step up
+    
+    // Class-wide load shedding (the coordinator writes shed, perform only reads it)
+    long priority;              // 0 = shed first (pads) .. PRIORITY_MAX = shed last (leads)
+    t_int32_atomic shed;        // Tier set by the coordinator; perform runs at the higher of this and quality
+    double coordinator_share;   // Coordinator-only working copy of load_share
+    double cost;                // Last predicted ns per sample (@cost)
+    struct _ssm2044 *next_instance; // Registry link
+    
+    // Reproducible rendering (render farms, regression tests)
+    long deterministic;         // 1 = same output bits on every host: full tier, no libm per sample
     
-    // Oversampling support (future enhancement)
-    long oversample_factor;     // 1, 2, or 4x oversampling
-    double *oversample_buffer;  // Buffer for oversampling
+    // Bypass with crossfade (idle bypass is a copy)
+    long bypass;                // 1 = crossfade to the dry input
+    long bypass_mode;           // BYPASS_FREEZE / BYPASS_DECAY
+    double bypass_mix;          // 0 = filtered, 1 = dry
+    
+    // Input saturation curve
+    long saturation;            // SATURATION_SYMMETRIC / _ASYMMETRIC
+    
+    // Output conditioning fused into the output write
+    long dcblock;               // 1 = DC-blocking one-pole on every outlet
+    long limit;                 // 1 = soft limiter to +-1.0 on every outlet
+    t_ssm2044_dcblocker dcblockers[1 + TAP_OUTLETS];
+    
+    // Multimode taps (extra outlets only exist when created with @taps 1)
+    long taps;                  // Creation-time flag: 1 = LP6/LP12/LP18/BP/HP outlets
+    long outlets_created;       // 1 once new has made the outlets (@taps is fixed from then on)
+    t_ssm2044_decimator tap_decimators[TAP_OUTLETS];
     
 } t_ssm2044;
 
@@ -91,23 +472,209 @@ void ssm2044_float(t_ssm2044 *x, double f);
 void ssm2044_int(t_ssm2044 *x, long n);
 void ssm2044_assist(t_ssm2044 *x, void *b, long m, long a, char *s);
 
-// Filter processing functions
-double ssm2044_process_sample(t_ssm2044 *x, double input, double cutoff, double resonance, double gain);
+// One block's inputs for the per-sample loop, prepared once per perform call
+typedef struct _ssm2044_block {
+    double *audio_in;
+    const double *cutoff_in;
+    double *resonance_in;
+    double *gain_in;
+    double *morph_in;
+    const double *fm_in;
+    double *out;
+    double *tap_out[TAP_OUTLETS];
+    long taps;
+    long sampleframes;
+    long factor;                // Oversampling factor this block runs at
+    double *conditioned;        // Scratch slot with the conditioned input (NULL: per frame)
+    double *fm_coeffs;          // Pre-pass cutoff coefficients, or NULL
+    long fm_prepass;            // 1 = exact FM coefficient every sample
+    double *cutoff_target;      // g, or the DK table position
+    const double *cv_table;
+    long interval;              // Cutoff coefficient interval
+    long rate_switched;         // 1 = start the factor-change declick
+    long stabilize;
+    double block_peak;          // Out: peak of the feedback node for the stabilizer
+} t_ssm2044_block;
+
+// Filter processing functions (kernels are inlined into per-model copies of the block loop)
+typedef double (*t_ssm2044_kernel)(t_ssm2044 *x, double saturated_input);
+typedef void (*t_ssm2044_loop)(t_ssm2044 *x, t_ssm2044_block *b);
+SSM2044_KERNEL void ssm2044_run_block(t_ssm2044 *x, t_ssm2044_block *b, t_ssm2044_kernel process);
+SSM2044_KERNEL double ssm2044_cascade_kernel(t_ssm2044 *x, double saturated_input, double feedback_drive,
+                                             long table_feedback);
+SSM2044_KERNEL double ssm2044_ota_kernel(t_ssm2044 *x, double saturated_input, double feedback_drive);
+SSM2044_KERNEL double ssm2044_wdf_kernel(t_ssm2044 *x, double saturated_input, double feedback_drive);
+SSM2044_KERNEL double ssm2044_dk_kernel(t_ssm2044 *x, double saturated_input, double feedback_drive);
+double ota_curve(double input);
+void ssm2044_wdf_adapt(t_ssm2044_wdf *w, double g, double k);
+double ssm2044_wdf_root(double q, double c);
+t_max_err ssm2044_model_attribute(t_ssm2044 *x, void *attr, long argc, t_atom *argv);
+
+#define SSM2044_DECLARE_KERNELS(name, input_drive, feedback_drive, resonance_scale, max_resonance) \
+    SSM2044_KERNEL double ssm2044_process_cascade_##name(t_ssm2044 *x, double saturated_input); \
+    SSM2044_KERNEL double ssm2044_process_ota_##name(t_ssm2044 *x, double saturated_input); \
+    SSM2044_KERNEL double ssm2044_process_wdf_##name(t_ssm2044 *x, double saturated_input); \
+    SSM2044_KERNEL double ssm2044_process_dk_##name(t_ssm2044 *x, double saturated_input); \
+    SSM2044_KERNEL double ssm2044_process_cascade_table_##name(t_ssm2044 *x, double saturated_input); \
+    void ssm2044_loop_cascade_##name(t_ssm2044 *x, t_ssm2044_block *b); \
+    void ssm2044_loop_ota_##name(t_ssm2044 *x, t_ssm2044_block *b); \
+    void ssm2044_loop_wdf_##name(t_ssm2044 *x, t_ssm2044_block *b); \
+    void ssm2044_loop_dk_##name(t_ssm2044 *x, t_ssm2044_block *b); \
+    void ssm2044_loop_cascade_table_##name(t_ssm2044 *x, t_ssm2044_block *b);
+SSM2044_MODELS(SSM2044_DECLARE_KERNELS)
+void ssm2044_build_dk_table(void);
+double ssm2044_cv_to_hz(const double *table, double volts);
+void ssm2044_build_cv_tables(void);
+t_max_err ssm2044_engine_attribute(t_ssm2044 *x, void *attr, long argc, t_atom *argv);
+void ssm2044_seed_engine(t_ssm2044 *x, long engine);
+t_max_err ssm2044_budget_attribute(t_ssm2044 *x, void *attr, long argc, t_atom *argv);
+void ssm2044_watchdog_update(t_ssm2044 *x, long sampleframes);
+void ssm2044_totalbudget(t_ssm2044 *x, double budget);
+void ssm2044_coordinate(void *unused);
+long ssm2044_kernel_index(t_ssm2044 *x, long engine);
+void ssm2044_cost(t_ssm2044 *x, long voices);
+t_max_err ssm2044_cost_get(t_ssm2044 *x, void *attr, long *argc, t_atom **argv);
+double ssm2044_predict_cost(t_ssm2044 *x);
+void ssm2044_calibrate_costs(void);
+void ssm2044_condition_frame(t_ssm2044 *x, double input, double gain, double *frame, long factor);
+void ssm2044_condition_block(t_ssm2044 *x, const double *src, double *dst, const double *gain_in,
+                             long sampleframes, long factor);
+void ssm2044_compute_taps(t_ssm2044 *x, double *taps);
+t_max_err ssm2044_taps_attribute(t_ssm2044 *x, void *attr, long argc, t_atom *argv);
+void ssm2044_perform_bypassed(t_ssm2044 *x, double *audio_in, double *out, double **tap_out,
+                              long taps, long sampleframes);
+void ssm2044_morph_weights(double morph, double *weights);
+double ssm2044_morph_mix(t_ssm2044 *x, const double *weights);
+void ssm2044_build_morph_table(void);
 double denormal_fix(double value);
 double soft_saturation(double input, double drive);
-void compute_filter_coefficients(t_ssm2044 *x, double cutoff, double resonance);
+double soft_limit(double input);
+double asymmetric_saturation(double input, double drive);
+double asymmetric_curve(double driven);
+double table_tanh(double u);
+void ssm2044_build_tanh_table(void);
+void ssm2044_build_saturation_table(void);
+double ssm2044_dc_block(t_ssm2044_dcblocker *dc, double input, double coeff);
+double compute_cutoff_coefficient(t_ssm2044 *x, double cutoff);
+double ssm2044_cutoff_hz(double raw, double fm, const double *cv_table);
+long ssm2044_coefficient_interval(t_ssm2044 *x, const double *cutoff_in, const double *cv_table,
+                                  long sampleframes);
+void compute_resonance_coefficients(t_ssm2044 *x, double resonance);
+void ssm2044_fm_coefficients(t_ssm2044 *x, const double *cutoff_in, const double *fm_in,
+                             const double *cv_table, double *coeffs, long sampleframes);
+SSM2044_KERNEL double ssm2044_prewarp_gain(double w);
+t_max_err ssm2044_compensation_attribute(t_ssm2044 *x, void *attr, long argc, t_atom *argv);
+void ssm2044_stabilizer_update(t_ssm2044 *x, double block_peak, long sampleframes);
+void ssm2044_kick(t_ssm2044 *x);
+void ssm2044_post_kick(t_ssm2044 *x, long shape);
+void ssm2044_apply_kick(t_ssm2044 *x, long shape);
 
 // Oversampling functions
-void ssm2044_oversample_attribute(t_ssm2044 *x, t_symbol *s, long argc, t_atom *argv);
+void ssm2044_build_decimator_kernels(void);
+void ssm2044_prepare_shared_tables(void);
+double ssm2044_exp(double v);
+double ssm2044_log(double v);
+void ssm2044_sincos(double v, double *sine, double *cosine);
+double ssm2044_sin(double v);
+double ssm2044_cos(double v);
+double ssm2044_tan(double v);
+double ssm2044_tanh(double v);
+void ssm2044_update_rate_cache(t_ssm2044 *x, double samplerate, long maxvectorsize);
+const double *ssm2044_tune_table_for_rate(double filter_sr);
+void ssm2044_tune_table_release(const double *g);
+void ssm2044_release_rate_cache(t_ssm2044 *x);
+void ssm2044_decimator_reset(t_ssm2044_decimator *d);
+void ssm2044_decimator_prime(t_ssm2044_decimator *d, double value);
+double ssm2044_decimator_push(t_ssm2044_decimator *d, const double *samples, long factor);
+void ssm2044_scratch_reserve(long maxvectorsize);
+long ssm2044_scratch_acquire(long sampleframes);
+void ssm2044_scratch_release(long slot);
+void ssm2044_scratch_warning(t_ssm2044 *x);
 
 // Class pointer
 static t_class *ssm2044_class = NULL;
 
+// Voicings and their kernels, indexed by @model
+#define SSM2044_VOICING_ROW(name, input_drive, feedback_drive, resonance_scale, max_resonance) \
+    { input_drive, resonance_scale, max_resonance },
+static const t_ssm2044_voicing ssm2044_voicings[MODELS] = {
+    SSM2044_MODELS(SSM2044_VOICING_ROW)
+};
+
+#define SSM2044_KERNEL_ROW(name, input_drive, feedback_drive, resonance_scale, max_resonance) \
+    { ssm2044_process_cascade_##name, ssm2044_process_ota_##name, \
+      ssm2044_process_wdf_##name, ssm2044_process_dk_##name, ssm2044_process_cascade_table_##name },
+static const t_ssm2044_kernel ssm2044_kernels[MODELS][KERNELS] = {
+    SSM2044_MODELS(SSM2044_KERNEL_ROW)
+};
+
+#define SSM2044_LOOP_ROW(name, input_drive, feedback_drive, resonance_scale, max_resonance) \
+    { ssm2044_loop_cascade_##name, ssm2044_loop_ota_##name, \
+      ssm2044_loop_wdf_##name, ssm2044_loop_dk_##name, ssm2044_loop_cascade_table_##name },
+static const t_ssm2044_loop ssm2044_loops[MODELS][KERNELS] = {
+    SSM2044_MODELS(SSM2044_LOOP_ROW)
+};
+
+// Shared oversampling scratch pool. A perform call holds a slot only while it runs, so
+// the pool needs one slot per block running at the same moment (one per busy audio
+// thread), however many threads have come and gone. Slots are sized in dsp64 for the
+// largest vector seen; a slot is only resized while the main thread holds it, since a
+// chain compiled later (poly~, pfft~) may arrive while other threads are running.
+static double *ssm2044_scratch_pool[SCRATCH_SLOTS];
+static long ssm2044_scratch_frames[SCRATCH_SLOTS];       // Base-rate frames each slot holds
+static t_int32_atomic ssm2044_scratch_busy[SCRATCH_SLOTS]; // 1 while a block holds the slot
+
+// Instance registry and budget for class-wide load shedding. The registry is changed in
+// new/free and walked by the coordinator clock, both inside a critical region; the audio
+// thread never touches it and only reads its own instance's shed tier.
+static t_ssm2044 *ssm2044_instances = NULL;
+static double ssm2044_total_budget = 0.0;       // Percent of real time for all instances (0 = off)
+static void *ssm2044_coordinator_clock = NULL;  // Created by totalbudget, freed with the last instance
+
+// Component costs on this machine, measured by the first cost query
+static t_ssm2044_costs ssm2044_costs;
+static volatile double ssm2044_calibration_sink;   // Keeps the timed loops from being optimized out
+
+// Pitch calibration tables, built from dsp64 once per distinct processing rate
+static t_ssm2044_tune_table ssm2044_tune_tables[TUNE_TABLE_SLOTS];
+
+// Windowed-sinc decimation kernels, one per oversampling factor
+static double ssm2044_decimator_kernels[MAX_OVERSAMPLE + 1][MAX_DECIMATOR_TAPS];
+
+// Asymmetric saturation curve, so even harmonics cost one table read instead of a second tanh
+static double ssm2044_saturation_table[SATURATION_TABLE_SIZE + 1];
+
+// Corner frequency (Hz) at 0, 1, ... 10 V per curve. Only the ideal exponential converter
+// ships until real voice cards have been measured; a measured card is one more row here
+// (and one more enum entry and menu item).
+static const double ssm2044_cv_breakpoints[CV_CURVES - 1][CV_BREAKPOINTS] = {
+    { 16.352, 32.703, 65.406, 130.81, 261.63, 523.25, 1046.5, 2093.0, 4186.0, 8372.0, 16744.0 }  // 1 V/oct
+};
+
+// Dense CV -> Hz tables expanded from the breakpoints, one interpolated read per update
+static double ssm2044_cv_tables[CV_CURVES - 1][CV_TABLE_SIZE + 1];
+
+// Discretized DK matrices by normalized cutoff, interpolated under modulation
+static t_ssm2044_dk_matrices ssm2044_dk_table[DK_TABLE_SIZE + 1];
+
+// tanh sampled once for the table-solved nonlinearities, as {value, slope to the next row}
+static double ssm2044_tanh_table[TANH_TABLE_SIZE + 1][2];
+
+// Morph weight rows, interpolated per sample by ssm2044_morph_weights
+static double ssm2044_morph_table[MORPH_TABLE_SIZE + 1][MORPH_WEIGHTS];
+
+// Shared tables are built by the first dsp64 call, not at load or instantiation
+static long ssm2044_tables_ready = 0;
+
 //----------------------------------------------------------------------------------------------
 
 void ext_main(void *r) {
     t_class *c;
     
+#if SSM2044_RT_CHECK
+    ssm2044_rt_install();
+#endif
+    
     c = class_new("ssm2044~", (method)ssm2044_new, (method)ssm2044_free,
                   sizeof(t_ssm2044), 0L, A_GIMME, 0);
     
@@ -115,13 +682,149 @@ void ext_main(void *r) {
     class_addmethod(c, (method)ssm2044_assist, "assist", A_CANT, 0);
     class_addmethod(c, (method)ssm2044_float, "float", A_FLOAT, 0);
     class_addmethod(c, (method)ssm2044_int, "int", A_LONG, 0);
+    class_addmethod(c, (method)ssm2044_kick, "kick", 0);
+    class_addmethod(c, (method)ssm2044_totalbudget, "totalbudget", A_FLOAT, 0);
+    class_addmethod(c, (method)ssm2044_cost, "cost", A_DEFLONG, 0);
     
     // Add oversampling attribute
     CLASS_ATTR_LONG(c, "oversample", 0, t_ssm2044, oversample_factor);
-    CLASS_ATTR_FILTER_CLIP(c, "oversample", 1, 4);
+    CLASS_ATTR_FILTER_CLIP(c, "oversample", 1, MAX_OVERSAMPLE);
     CLASS_ATTR_LABEL(c, "oversample", 0, "Oversampling Factor");
     CLASS_ATTR_SAVE(c, "oversample", 0);
     
+    // Resonance gain compensation
+    CLASS_ATTR_LONG(c, "compensation", 0, t_ssm2044, compensation);
+    CLASS_ATTR_FILTER_CLIP(c, "compensation", COMPENSATION_OFF, COMPENSATION_FULL);
+    CLASS_ATTR_ACCESSORS(c, "compensation", NULL, ssm2044_compensation_attribute);
+    CLASS_ATTR_ENUMINDEX3(c, "compensation", 0, "Off", "Musical", "Full");
+    CLASS_ATTR_LABEL(c, "compensation", 0, "Resonance Compensation");
+    CLASS_ATTR_SAVE(c, "compensation", 0);
+    
+    // Self-oscillation amplitude stabilizer
+    CLASS_ATTR_LONG(c, "stabilize", 0, t_ssm2044, stabilize);
+    CLASS_ATTR_FILTER_CLIP(c, "stabilize", 0, 1);
+    CLASS_ATTR_STYLE_LABEL(c, "stabilize", 0, "onoff", "Stabilize Self-Oscillation");
+    CLASS_ATTR_SAVE(c, "stabilize", 0);
+    
+    CLASS_ATTR_DOUBLE(c, "stablevel", 0, t_ssm2044, stabilize_level);
+    CLASS_ATTR_FILTER_CLIP(c, "stablevel", 0.01, 2.0);
+    CLASS_ATTR_LABEL(c, "stablevel", 0, "Self-Oscillation Level");
+    CLASS_ATTR_SAVE(c, "stablevel", 0);
+    
+    // Self-oscillation excitation
+    CLASS_ATTR_LONG(c, "kickmode", 0, t_ssm2044, kick_mode);
+    CLASS_ATTR_FILTER_CLIP(c, "kickmode", KICK_OFF, KICK_STEP);
+    CLASS_ATTR_ENUMINDEX3(c, "kickmode", 0, "Off", "Impulse", "Step");
+    CLASS_ATTR_LABEL(c, "kickmode", 0, "Kick on Oscillation Threshold");
+    CLASS_ATTR_SAVE(c, "kickmode", 0);
+    
+    CLASS_ATTR_DOUBLE(c, "kickamp", 0, t_ssm2044, kick_amount);
+    CLASS_ATTR_FILTER_CLIP(c, "kickamp", 0.0, 1.0);
+    CLASS_ATTR_LABEL(c, "kickamp", 0, "Kick Amount");
+    CLASS_ATTR_SAVE(c, "kickamp", 0);
+    
+    // Self-oscillation pitch calibration
+    CLASS_ATTR_LONG(c, "tune", 0, t_ssm2044, tune);
+    CLASS_ATTR_FILTER_CLIP(c, "tune", 0, 1);
+    CLASS_ATTR_STYLE_LABEL(c, "tune", 0, "onoff", "Tuned Resonance");
+    CLASS_ATTR_SAVE(c, "tune", 0);
+    
+    // Filter engine
+    CLASS_ATTR_LONG(c, "engine", 0, t_ssm2044, engine);
+    CLASS_ATTR_FILTER_CLIP(c, "engine", ENGINE_CASCADE, ENGINE_DK);
+    CLASS_ATTR_ACCESSORS(c, "engine", NULL, ssm2044_engine_attribute);
+    CLASS_ATTR_ENUMINDEX3(c, "engine", 0, "Cascade", "Wave Digital", "DK State-Space");
+    CLASS_ATTR_LABEL(c, "engine", 0, "Filter Engine");
+    CLASS_ATTR_SAVE(c, "engine", 0);
+    
+    CLASS_ATTR_LONG(c, "stagesat", 0, t_ssm2044, stage_saturation);
+    CLASS_ATTR_FILTER_CLIP(c, "stagesat", 0, 1);
+    CLASS_ATTR_STYLE_LABEL(c, "stagesat", 0, "onoff", "Per-Stage OTA Saturation (Cascade)");
+    CLASS_ATTR_SAVE(c, "stagesat", 0);
+    
+    // Vintage voicing
+    CLASS_ATTR_LONG(c, "model", 0, t_ssm2044, model);
+    CLASS_ATTR_FILTER_CLIP(c, "model", MODEL_SSM2044, MODELS - 1);
+    CLASS_ATTR_ACCESSORS(c, "model", NULL, ssm2044_model_attribute);
+    CLASS_ATTR_ENUMINDEX4(c, "model", 0, "SSM2044", "Polysix", "Mono/Poly", "Pro-One");
+    CLASS_ATTR_LABEL(c, "model", 0, "Voicing");
+    CLASS_ATTR_SAVE(c, "model", 0);
+    
+    // Cutoff CV response
+    CLASS_ATTR_LONG(c, "cvcurve", 0, t_ssm2044, cv_curve);
+    CLASS_ATTR_FILTER_CLIP(c, "cvcurve", CV_CURVE_OFF, CV_CURVES - 1);
+    CLASS_ATTR_ENUMINDEX2(c, "cvcurve", 0, "Off (Hz)", "1 V/oct");
+    CLASS_ATTR_LABEL(c, "cvcurve", 0, "Cutoff CV Response");
+    CLASS_ATTR_SAVE(c, "cvcurve", 0);
+    
+    // CPU watchdog
+    CLASS_ATTR_DOUBLE(c, "budget", 0, t_ssm2044, budget);
+    CLASS_ATTR_FILTER_CLIP(c, "budget", 0.0, 100.0);
+    CLASS_ATTR_ACCESSORS(c, "budget", NULL, ssm2044_budget_attribute);
+    CLASS_ATTR_LABEL(c, "budget", 0, "CPU Budget (% of Real Time, 0 = Off)");
+    CLASS_ATTR_SAVE(c, "budget", 0);
+    
+    CLASS_ATTR_LONG(c, "quality", ATTR_SET_OPAQUE_USER, t_ssm2044, quality);
+    CLASS_ATTR_ENUMINDEX4(c, "quality", 0, "Full", "Decimated", "Base Rate", "Cascade");
+    CLASS_ATTR_LABEL(c, "quality", 0, "Current Quality Tier (read-only)");
+    
+    CLASS_ATTR_LONG(c, "priority", 0, t_ssm2044, priority);
+    CLASS_ATTR_FILTER_CLIP(c, "priority", 0, PRIORITY_MAX);
+    CLASS_ATTR_LABEL(c, "priority", 0, "Load-Shedding Priority (higher keeps quality longer)");
+    CLASS_ATTR_SAVE(c, "priority", 0);
+    
+    CLASS_ATTR_INT32(c, "shed", ATTR_SET_OPAQUE_USER, t_ssm2044, shed);
+    CLASS_ATTR_ENUMINDEX4(c, "shed", 0, "Full", "Decimated", "Base Rate", "Cascade");
+    CLASS_ATTR_LABEL(c, "shed", 0, "Tier Set by totalbudget (read-only)");
+    
+    // Predicted cost of the current settings
+    CLASS_ATTR_DOUBLE(c, "cost", ATTR_SET_OPAQUE_USER, t_ssm2044, cost);
+    CLASS_ATTR_ACCESSORS(c, "cost", ssm2044_cost_get, NULL);
+    CLASS_ATTR_LABEL(c, "cost", 0, "Predicted ns per Sample (read-only)");
+    
+    // Bit-identical output across machines
+    CLASS_ATTR_LONG(c, "deterministic", 0, t_ssm2044, deterministic);
+    CLASS_ATTR_FILTER_CLIP(c, "deterministic", 0, 1);
+    CLASS_ATTR_STYLE_LABEL(c, "deterministic", 0, "onoff", "Deterministic Output");
+    CLASS_ATTR_SAVE(c, "deterministic", 0);
+    
+    // Bypass
+    CLASS_ATTR_LONG(c, "bypass", 0, t_ssm2044, bypass);
+    CLASS_ATTR_FILTER_CLIP(c, "bypass", 0, 1);
+    CLASS_ATTR_STYLE_LABEL(c, "bypass", 0, "onoff", "Bypass");
+    CLASS_ATTR_SAVE(c, "bypass", 0);
+    
+    CLASS_ATTR_LONG(c, "bypassmode", 0, t_ssm2044, bypass_mode);
+    CLASS_ATTR_FILTER_CLIP(c, "bypassmode", BYPASS_FREEZE, BYPASS_DECAY);
+    CLASS_ATTR_ENUMINDEX2(c, "bypassmode", 0, "Freeze", "Decay");
+    CLASS_ATTR_LABEL(c, "bypassmode", 0, "Filter State While Bypassed");
+    CLASS_ATTR_SAVE(c, "bypassmode", 0);
+    
+    // Input saturation curve
+    CLASS_ATTR_LONG(c, "saturation", 0, t_ssm2044, saturation);
+    CLASS_ATTR_FILTER_CLIP(c, "saturation", SATURATION_SYMMETRIC, SATURATION_ASYMMETRIC);
+    CLASS_ATTR_ENUMINDEX2(c, "saturation", 0, "Symmetric", "Asymmetric");
+    CLASS_ATTR_LABEL(c, "saturation", 0, "Input Saturation Curve");
+    CLASS_ATTR_SAVE(c, "saturation", 0);
+    
+    // Output conditioning
+    CLASS_ATTR_LONG(c, "dcblock", 0, t_ssm2044, dcblock);
+    CLASS_ATTR_FILTER_CLIP(c, "dcblock", 0, 1);
+    CLASS_ATTR_STYLE_LABEL(c, "dcblock", 0, "onoff", "Output DC Blocker");
+    CLASS_ATTR_SAVE(c, "dcblock", 0);
+    
+    CLASS_ATTR_LONG(c, "limit", 0, t_ssm2044, limit);
+    CLASS_ATTR_FILTER_CLIP(c, "limit", 0, 1);
+    CLASS_ATTR_STYLE_LABEL(c, "limit", 0, "onoff", "Output Soft Limiter");
+    CLASS_ATTR_SAVE(c, "limit", 0);
+    
+    // Multimode tap outlets, fixed at creation time
+    CLASS_ATTR_LONG(c, "taps", 0, t_ssm2044, taps);
+    CLASS_ATTR_FILTER_CLIP(c, "taps", 0, 1);
+    CLASS_ATTR_ACCESSORS(c, "taps", NULL, ssm2044_taps_attribute);
+    CLASS_ATTR_STYLE_LABEL(c, "taps", 0, "onoff", "Multimode Tap Outlets (creation only)");
+    CLASS_ATTR_SAVE(c, "taps", 0);
+    
     class_dspinit(c);
     class_register(CLASS_BOX, c);
     ssm2044_class = c;
@@ -130,17 +833,19 @@ void ext_main(void *r) {
 //----------------------------------------------------------------------------------------------
 
 void *ssm2044_new(t_symbol *s, long argc, t_atom *argv) {
+    // Kept to plain field setup: large patches create thousands of these, so
+    // allocations and table builds wait for dsp64 (object_alloc zeroes the struct)
     t_ssm2044 *x = (t_ssm2044 *)object_alloc(ssm2044_class);
     
     if (x) {
-        // lores~ pattern: 4 signal inlets (audio, cutoff, resonance, gain)
-        // Note: audio input is automatically created, so we need 3 additional inlets
-        dsp_setup((t_pxobject *)x, 4);
-        outlet_new(x, "signal");
+        // lores~ pattern: 6 signal inlets (audio, cutoff, resonance, gain, morph, FM)
+        dsp_setup((t_pxobject *)x, 6);
         
         // Initialize core state
         x->sr = sys_getsr();
         x->sr_inv = 1.0 / x->sr;
+        x->filter_sr = x->sr;
+        x->filter_sr_inv = x->sr_inv;
         
         // Initialize filter state
         x->state1 = x->state2 = x->state3 = x->state4 = 0.0;
@@ -155,18 +860,76 @@ void *ssm2044_new(t_symbol *s, long argc, t_atom *argv) {
         x->cutoff_has_signal = 0;
         x->resonance_has_signal = 0;
         x->gain_has_signal = 0;
+        x->morph_has_signal = 0;
+        x->morph_float = 0.0;          // Plain LP24 output
+        x->fm_has_signal = 0;
+        x->fm_float = 0.0;
         
         // Initialize filter coefficients
         x->g = 0.0;
         x->k = 0.0;
+        x->cutoff_prev = 0.0;
+        x->coeff_interval = 1;         // Predict the per-sample worst case until perform has run
+        x->coeff_resonance = -1.0;     // Force the first resonance update
+        
+        // Initialize self-oscillation stabilizer
+        x->stabilize = 0;
+        x->stabilize_level = 0.5;
+        x->stabilize_trim = 1.0;
+        x->stabilize_env = 0.0;
+        
+        // Initialize excitation kick
+        x->kick_mode = KICK_OFF;
+        x->kick_amount = 0.1;
+        x->kick_step = 0.0;
+        x->kick_pending = 0;
+        x->kick_prev_k = 0.0;
+        
+        // Initialize resonance compensation
+        x->compensation = COMPENSATION_OFF;
+        x->output_gain = 1.0;
         
         // Initialize oversampling
         x->oversample_factor = 1;      // No oversampling by default
-        x->oversample_buffer = NULL;
+        x->active_factor = 1;
+        x->output_history[0] = x->output_history[1] = 0.0;
+        x->declick = 0.0;
+        x->declick_step = 0.0;
+        x->maxvectorsize = 0;
+        x->upsample_prev = 0.0;
+        x->scratch_warned = 0;
+        x->scratch_qelem = qelem_new(x, (method)ssm2044_scratch_warning);
+        
+        // Initialize filter engine
+        x->engine = ENGINE_CASCADE;
+        x->active_engine = ENGINE_CASCADE;
+        x->wdf.g = -1.0;               // Derive the adaptors on first use
+        x->dk.position_key = -1.0;     // Interpolate the matrices on first use
+        
+        // Initialize CPU watchdog (off)
+        x->budget = 0.0;
+        x->quality = QUALITY_FULL;
+        x->load_share = 0.0;
+        x->load_time = 0.0;
+        x->watchdog_over = 0;
+        x->watchdog_calm = 0.0;
+        x->watchdog_recover = WATCHDOG_RECOVER_TIME;
+        x->watchdog_stepped_up = 0;
+        
+        // Join the load-shedding registry
+        x->priority = PRIORITY_MAX / 2;
+        x->shed = QUALITY_FULL;
+        x->coordinator_share = 0.0;
+        x->cost = 0.0;
+        x->deterministic = 0;
+        critical_enter(0);
+        x->next_instance = ssm2044_instances;
+        ssm2044_instances = x;
+        critical_exit(0);
         
         // Process creation arguments if any
         if (argc >= 1 && (atom_gettype(argv) == A_FLOAT || atom_gettype(argv) == A_LONG)) {
-            x->cutoff_float = CLAMP(atom_getfloat(argv), 20.0, 20000.0);
+            x->cutoff_float = CLAMP(atom_getfloat(argv), 0.0, 20000.0);  // Hz, or volts with @cvcurve
         }
         if (argc >= 2 && (atom_gettype(argv + 1) == A_FLOAT || atom_gettype(argv + 1) == A_LONG)) {
             x->resonance_float = CLAMP(atom_getfloat(argv + 1), 0.0, 4.0);
@@ -175,14 +938,20 @@ void *ssm2044_new(t_symbol *s, long argc, t_atom *argv) {
             x->gain_float = CLAMP(atom_getfloat(argv + 2), 0.0, 4.0);
         }
         
-        // Allocate oversampling buffer if needed
-        if (x->oversample_factor > 1) {
-            x->oversample_buffer = (double *)malloc(sizeof(double) * 4096 * x->oversample_factor);
-            if (!x->oversample_buffer) {
-                post("ssm2044~: could not allocate oversampling buffer");
-                x->oversample_factor = 1;
+        // Process @attribute arguments (e.g. @oversample 2)
+        attr_args_process(x, argc, argv);
+        
+        // A patch saved bypassed opens bypassed instead of fading to dry
+        x->bypass_mix = x->bypass ? 1.0 : 0.0;
+        
+        // Outlets come after attributes: @taps decides how many there are
+        outlet_new(x, "signal");
+        if (x->taps) {
+            for (long i = 0; i < TAP_OUTLETS; i++) {
+                outlet_new(x, "signal");
             }
         }
+        x->outlets_created = 1;
     }
     
     return x;
@@ -191,23 +960,59 @@ void *ssm2044_new(t_symbol *s, long argc, t_atom *argv) {
 //----------------------------------------------------------------------------------------------
 
 void ssm2044_free(t_ssm2044 *x) {
-    if (x->oversample_buffer) {
-        free(x->oversample_buffer);
-    }
     dsp_free((t_pxobject *)x);
+    qelem_free(x->scratch_qelem);
+    ssm2044_release_rate_cache(x);
+    
+    critical_enter(0);
+    for (t_ssm2044 **link = &ssm2044_instances; *link; link = &(*link)->next_instance) {
+        if (*link == x) {
+            *link = x->next_instance;
+            break;
+        }
+    }
+    long last = (ssm2044_instances == NULL);
+    critical_exit(0);
+    
+    // Last instance gone: stop the coordinator (the next totalbudget makes a new clock)
+    if (last && ssm2044_coordinator_clock) {
+        clock_unset(ssm2044_coordinator_clock);
+        object_free(ssm2044_coordinator_clock);
+        ssm2044_coordinator_clock = NULL;
+    }
 }
 
 //----------------------------------------------------------------------------------------------
 
 void ssm2044_dsp64(t_ssm2044 *x, t_object *dsp64, short *count, double samplerate, 
                    long maxvectorsize, long flags) {
-    x->sr = samplerate;
-    x->sr_inv = 1.0 / samplerate;
+    // Recompiles with an unchanged configuration reuse everything (and keep the filter ringing)
+    ssm2044_update_rate_cache(x, samplerate, maxvectorsize);
+    
+    // First DSP compile of any instance builds the class-wide tables
+    ssm2044_prepare_shared_tables();
+    
+    // Grow the shared scratch pool to this chain's vector size
+    ssm2044_scratch_reserve(maxvectorsize);
+    
+    // Every tune table slot held by other rates: say so once instead of silently detuning
+    if (x->tune && !x->tune_warned) {
+        for (long factor = 1; factor <= MAX_OVERSAMPLE; factor++) {
+            if (!x->rate.tune_table[factor]) {
+                x->tune_warned = 1;
+                object_warn((t_object *)x, "too many sample rates in use: @tune falls back to tan() at %.0f Hz",
+                            x->rate.filter_sr[factor]);
+                break;
+            }
+        }
+    }
     
     // lores~ pattern: store signal connection status
     x->cutoff_has_signal = count[1];    // Inlet 1 is cutoff
     x->resonance_has_signal = count[2]; // Inlet 2 is resonance
     x->gain_has_signal = count[3];      // Inlet 3 is gain
+    x->morph_has_signal = count[4];     // Inlet 4 is response morph
+    x->fm_has_signal = count[5];        // Inlet 5 is linear FM
     
     object_method(dsp64, gensym("dsp_add64"), x, ssm2044_perform64, 0, NULL);
 }
@@ -221,41 +1026,402 @@ void ssm2044_perform64(t_ssm2044 *x, t_object *dsp64, double **ins, long numins,
     double *cutoff_in = ins[1];     // Cutoff frequency
     double *resonance_in = ins[2];  // Resonance
     double *gain_in = ins[3];       // Input gain
+    double *morph_in = ins[4];      // Response morph
+    double *fm_in = ins[5];         // Linear FM (Hz)
     
-    // Output buffer
+    // Output buffers (tap outlets only exist with @taps 1)
     double *out = outs[0];
+    double *tap_out[TAP_OUTLETS] = { NULL };
+    long taps = x->taps && numouts > TAP_OUTLETS;
+    if (taps) {
+        for (long i = 0; i < TAP_OUTLETS; i++) {
+            tap_out[i] = outs[i + 1];
+        }
+    }
+    
+    SSM2044_PERFORM_BEGIN();
+    
+    // Last input and cutoff of the block, read before any outlet (which may share an inlet's
+    // buffer) is written
+    double last_input = audio_in[sampleframes - 1];
+    double last_cutoff = cutoff_in[sampleframes - 1];
+    
+    // Fully bypassed: no filtering at all, just pass the input through
+    if (x->bypass && x->bypass_mix >= 1.0) {
+        ssm2044_perform_bypassed(x, audio_in, out, tap_out, taps, sampleframes);
+        SSM2044_PERFORM_END();
+        return;
+    }
+    
+    // CPU watchdog and coordinator: time the block and run at the cheaper of the tiers
+    // the previous blocks left. Deterministic instances still publish their load but
+    // always run at full quality, since tiers follow the host's timing.
+    long deterministic = x->deterministic;
+    long timed = (x->budget > 0.0 || ssm2044_total_budget > 0.0);
+    double block_start = timed ? systimer_gettime() : 0.0;
+    long quality = x->quality;
+    long shed = x->shed;
+    if (shed > quality) {
+        quality = shed;
+    }
+    if (deterministic) {
+        quality = QUALITY_FULL;
+    }
+    
+    // Hold a scratch slot for this block. Without one the block runs the same way, just
+    // upsampling and conditioning one frame at a time (same output, more time)
+    long factor = (quality >= QUALITY_BASE_RATE) ? 1 : x->oversample_factor;
+    long slot = ssm2044_scratch_acquire(sampleframes);
+    double *conditioned = (slot >= 0) ? ssm2044_scratch_pool[slot] : NULL;
+    if (!conditioned && !x->scratch_warned) {
+        x->scratch_warned = 1;
+        qelem_set(x->scratch_qelem);
+    }
+    x->filter_sr = x->rate.filter_sr[factor];
+    x->filter_sr_inv = x->rate.filter_sr_inv[factor];
+    x->tune_table = x->rate.tune_table[factor];
+    x->tune_index_scale = x->rate.tune_index_scale[factor];
+    
+    // A new engine starts from the published stage voltages
+    long engine = (quality >= QUALITY_CASCADE) ? ENGINE_CASCADE : x->engine;
+    if (engine != x->active_engine) {
+        ssm2044_seed_engine(x, engine);
+    }
+    
+    // Decimators resume from the current output rather than stale history
+    if (factor > 1 && factor != x->active_factor) {
+        ssm2044_decimator_prime(&x->decimator, x->state4);
+        if (taps) {
+            double frame[TAP_OUTLETS];
+            ssm2044_compute_taps(x, frame);
+            for (long t = 0; t < TAP_OUTLETS; t++) {
+                ssm2044_decimator_prime(&x->tap_decimators[t], frame[t]);
+            }
+        }
+    }
+    
+    // Coefficients from another rate or engine are replaced exactly, not ramped
+    long rate_switched = (factor != x->active_factor);
+    long retune = (engine != x->active_engine || rate_switched);
+    x->active_engine = engine;
+    x->active_factor = factor;
+    
+    // Upsample the audio block by linear interpolation from the previous input
+    if (factor > 1 && conditioned) {
+        double prev = x->upsample_prev;
+        double step = 1.0 / factor;
+        double *dst = conditioned;
+        for (long i = 0; i < sampleframes; i++) {
+            double current = audio_in[i];
+            double delta = (current - prev) * step;
+            for (long j = 1; j <= factor; j++) {
+                *dst++ = prev + delta * j;
+            }
+            prev = current;
+        }
+        x->upsample_prev = prev;
+    }
+    
+    // Gain and input saturation don't depend on filter state: do them for the whole
+    // block up front so only the feedback recurrence remains in the serial loop
+    if (conditioned) {
+        ssm2044_condition_block(x, (factor > 1) ? conditioned : audio_in, conditioned,
+                                gain_in, sampleframes, factor);
+    }
+    
+    // Cutoff inlet in volts when a CV curve is selected
+    const double *cv_table = (x->cv_curve > CV_CURVE_OFF) ? ssm2044_cv_tables[x->cv_curve - 1] : NULL;
+    
+    // Audio-rate FM: build the block's cutoff coefficients in one vectorizable pass (per
+    // sample, with the same code, when there is no scratch)
+    long fm_prepass = x->fm_has_signal && quality < QUALITY_DECIMATED;
+    double *fm_coeffs = NULL;
+    double *cutoff_target = (engine == ENGINE_DK) ? &x->dk.position : &x->g;
+    if (fm_prepass && conditioned) {
+        fm_coeffs = conditioned + ssm2044_scratch_frames[slot] * MAX_OVERSAMPLE;
+        ssm2044_fm_coefficients(x, cutoff_in, fm_in, cv_table, fm_coeffs, sampleframes);
+    }
+    
+    // Otherwise cutoff coefficients are exact every `interval` samples and ramped in between
+    long interval;
+    if (fm_prepass || retune) {
+        interval = 1;
+    } else if (quality >= QUALITY_DECIMATED) {
+        interval = COEFF_INTERVAL_MAX;
+    } else {
+        interval = ssm2044_coefficient_interval(x, cutoff_in, cv_table, sampleframes);
+    }
+    x->coeff_interval = interval;
+    // Per-sample loop compiled for this block's voicing and kernel
+    t_ssm2044_block block;
+    block.audio_in = audio_in;
+    block.cutoff_in = cutoff_in;
+    block.resonance_in = resonance_in;
+    block.gain_in = gain_in;
+    block.morph_in = morph_in;
+    block.fm_in = fm_in;
+    block.out = out;
+    for (long t = 0; t < TAP_OUTLETS; t++) {
+        block.tap_out[t] = tap_out[t];
+    }
+    block.taps = taps;
+    block.sampleframes = sampleframes;
+    block.factor = factor;
+    block.conditioned = conditioned;
+    block.fm_coeffs = fm_coeffs;
+    block.fm_prepass = fm_prepass;
+    block.cutoff_target = cutoff_target;
+    block.cv_table = cv_table;
+    block.interval = interval;
+    block.rate_switched = rate_switched;
+    block.stabilize = x->stabilize;
+    ssm2044_loops[x->model][ssm2044_kernel_index(x, engine)](x, &block);
+    
+    if (x->cutoff_has_signal) {
+        x->cutoff_prev = last_cutoff;
+    }
+    if (factor == 1) {
+        x->upsample_prev = last_input;      // Upsampler resumes without a step
+    }
+    
+    if (slot >= 0) {
+        ssm2044_scratch_release(slot);
+    }
+    
+    if (block.stabilize) {
+        ssm2044_stabilizer_update(x, block.block_peak, sampleframes);
+    }
+    
+    if (timed) {
+        // Published for the coordinator as well as used by this instance's watchdog
+        double block_end = systimer_gettime();
+        double share = (block_end - block_start) / (sampleframes * x->sr_inv * 1000.0);
+        x->load_share += WATCHDOG_SMOOTHING * (share - x->load_share);
+        x->load_time = block_end;
+        if (x->budget > 0.0 && !deterministic) {
+            ssm2044_watchdog_update(x, sampleframes);
+        }
+    }
+    
+    SSM2044_PERFORM_END();
+}
+
+//----------------------------------------------------------------------------------------------
+
+SSM2044_KERNEL void ssm2044_run_block(t_ssm2044 *x, t_ssm2044_block *b, t_ssm2044_kernel process) {
+    // The per-sample loop. Every (model, kernel) pair gets its own copy (ssm2044_loops),
+    // so process is a constant here and the kernel is inlined, not called per sample.
+    // Block inputs prepared by perform, in locals so the loop keeps them in registers
+    double *audio_in = b->audio_in;
+    const double *cutoff_in = b->cutoff_in;
+    double *resonance_in = b->resonance_in;
+    double *gain_in = b->gain_in;
+    double *morph_in = b->morph_in;
+    const double *fm_in = b->fm_in;
+    double *out = b->out;
+    double *tap_out[TAP_OUTLETS];
+    for (long t = 0; t < TAP_OUTLETS; t++) {
+        tap_out[t] = b->tap_out[t];
+    }
+    long taps = b->taps;
+    long sampleframes = b->sampleframes;
+    long factor = b->factor;
+    double *conditioned = b->conditioned;
+    double *fm_coeffs = b->fm_coeffs;
+    long fm_prepass = b->fm_prepass;
+    double *cutoff_target = b->cutoff_target;
+    const double *cv_table = b->cv_table;
+    long interval = b->interval;
+    long rate_switched = b->rate_switched;
+    
+    long ramping = x->cutoff_has_signal || x->fm_has_signal;
+    long coeff_countdown = 0;
+    double coeff_step = 0.0;
     
     long n = sampleframes;
+    double *os_in = conditioned;
+    double inline_frame[MAX_OVERSAMPLE];
+    
+    // Plain LP24 output unless the morph inlet is in use
+    long morphing = x->morph_has_signal || x->morph_float > 0.0;
+    double weights[MORPH_WEIGHTS];
+    
+    // Output conditioning flags are read once per block
+    long dcblock = x->dcblock;
+    long limit = x->limit;
+    double dc_coeff = x->rate.dc_coeff;
+    
+    // Wet/dry crossfade while entering or leaving bypass
+    double bypass_mix = x->bypass_mix;
+    double bypass_step = x->bypass ? x->rate.bypass_step : -x->rate.bypass_step;
+    long fading = x->bypass ? (bypass_mix < 1.0) : (bypass_mix > 0.0);
+    
+    double max_resonance = ssm2044_voicings[x->model].max_resonance;
+    
+    // Switching the resampler in or out shifts the output by the decimator delay: the step
+    // is bridged by an offset from the extrapolated old path that fades out
+    double history0 = x->output_history[0];
+    double history1 = x->output_history[1];
+    double declick = x->declick;
+    double declick_step = x->declick_step;
+    
+    // Peak of the feedback node for the stabilizer loop
+    long stabilize = b->stabilize;
+    double block_peak = 0.0;
     
     while (n--) {
         // lores~ pattern: choose signal vs float for each parameter
         double audio = *audio_in++;
-        double cutoff = x->cutoff_has_signal ? *cutoff_in++ : x->cutoff_float;
+        long i = sampleframes - 1 - n;
         double resonance = x->resonance_has_signal ? *resonance_in++ : x->resonance_float;
         double gain = x->gain_has_signal ? *gain_in++ : x->gain_float;
         
-        // Clamp parameters to valid ranges
-        cutoff = CLAMP(cutoff, 20.0, 20000.0);        // 20 Hz to 20 kHz
-        resonance = CLAMP(resonance, 0.0, MAX_RESONANCE); // 0 to 4 (self-oscillation above 3.5)
-        gain = CLAMP(gain, 0.0, 4.0);                 // 0 to 4x gain
+        // Clamp parameters to valid ranges (gain is clamped where it is applied)
+        resonance = CLAMP(resonance, 0.0, max_resonance); // Up to 4 (self-oscillation above ~3.5)
+        
+        if (morphing) {
+            double morph = x->morph_has_signal ? *morph_in++ : x->morph_float;
+            ssm2044_morph_weights(CLAMP(morph, 0.0, 1.0), weights);
+        }
+        
+        // Coefficients are held for all sub-samples of one input sample
+        if (fm_coeffs) {
+            *cutoff_target = *fm_coeffs++;
+        } else if (fm_prepass) {
+            ssm2044_fm_coefficients(x, cutoff_in + i, fm_in + i, cv_table, cutoff_target, 1);
+        } else {
+            if (coeff_countdown == 0) {
+                // Exact coefficient at the end of the next span, reached by a linear ramp
+                long span = (interval < n + 1) ? interval : n + 1;
+                long ahead = i + span - 1;
+                double raw = x->cutoff_has_signal ? cutoff_in[ahead] : x->cutoff_float;
+                double fm = x->fm_has_signal ? fm_in[ahead] : x->fm_float;
+                double target = compute_cutoff_coefficient(x, ssm2044_cutoff_hz(raw, fm, cv_table));
+                if (ramping && span > 1) {
+                    coeff_step = (target - *cutoff_target) / span;
+                } else {
+                    *cutoff_target = target;    // Float cutoffs step exactly, as before
+                    coeff_step = 0.0;
+                }
+                coeff_countdown = span;
+            }
+            *cutoff_target += coeff_step;
+            coeff_countdown--;
+        }
+        compute_resonance_coefficients(x, resonance);
+        
+        // Taken with a compare-and-swap, so a kick posted since the read stays pending
+        long kick = x->kick_pending;
+        if (kick && ATOMIC_COMPARE_SWAP32(kick, 0, &x->kick_pending)) {
+            ssm2044_apply_kick(x, kick);
+        }
+        
+        double filtered;
+        double tap_values[TAP_OUTLETS];
+        if (factor > 1) {
+            // Run the filter at the oversampled rate, then decimate back down
+            double tap_frames[TAP_OUTLETS][MAX_OVERSAMPLE];
+            if (!conditioned) {
+                ssm2044_condition_frame(x, audio, gain, inline_frame, factor);
+                os_in = inline_frame;
+            }
+            for (long j = 0; j < factor; j++) {
+                double y = process(x, os_in[j] + x->kick_step);
+                os_in[j] = morphing ? ssm2044_morph_mix(x, weights) : y;
+                if (taps) {
+                    double frame[TAP_OUTLETS];
+                    ssm2044_compute_taps(x, frame);
+                    for (long t = 0; t < TAP_OUTLETS; t++) {
+                        tap_frames[t][j] = frame[t];
+                    }
+                }
+            }
+            filtered = ssm2044_decimator_push(&x->decimator, os_in, factor);
+            if (taps) {
+                for (long t = 0; t < TAP_OUTLETS; t++) {
+                    tap_values[t] = ssm2044_decimator_push(&x->tap_decimators[t], tap_frames[t], factor);
+                }
+            }
+            os_in += factor;
+        } else {
+            double input;
+            if (conditioned) {
+                input = *os_in++;
+            } else {
+                ssm2044_condition_block(x, &audio, &input, &gain, 1, 1);
+            }
+            filtered = process(x, input + x->kick_step);
+            if (morphing) {
+                filtered = ssm2044_morph_mix(x, weights);
+            }
+            if (taps) {
+                ssm2044_compute_taps(x, tap_values);
+            }
+        }
+        
+        if (rate_switched) {
+            declick = 2.0 * history0 - history1 - filtered;
+            declick_step = fabs(declick) / (WATCHDOG_DECLICK_TIME * x->sr);
+            rate_switched = 0;
+        }
+        if (declick != 0.0) {
+            filtered += declick;
+            declick = (declick > declick_step) ? declick - declick_step
+                    : (declick < -declick_step) ? declick + declick_step : 0.0;
+        }
+        history1 = history0;
+        history0 = filtered;
         
-        // Process sample through filter
-        double filtered = ssm2044_process_sample(x, audio, cutoff, resonance, gain);
+        if (stabilize) {
+            double peak = fabs(x->state4);
+            block_peak = (peak > block_peak) ? peak : block_peak;
+        }
+        
+        // Apply compensation, optional DC blocker and limiter, denormal fix and output
+        double value = filtered * x->output_gain;
+        if (dcblock) {
+            value = ssm2044_dc_block(&x->dcblockers[0], value, dc_coeff);
+        }
+        if (limit) {
+            value = soft_limit(value);
+        }
+        if (fading) {
+            bypass_mix = CLAMP(bypass_mix + bypass_step, 0.0, 1.0);
+            value += bypass_mix * (audio - value);
+        }
+        *out++ = denormal_fix(value);
         
-        // Apply denormal fix and output
-        *out++ = denormal_fix(filtered);
+        if (taps) {
+            for (long t = 0; t < TAP_OUTLETS; t++) {
+                double tap = tap_values[t] * x->output_gain;
+                if (dcblock) {
+                    tap = ssm2044_dc_block(&x->dcblockers[t + 1], tap, dc_coeff);
+                }
+                if (limit) {
+                    tap = soft_limit(tap);
+                }
+                if (fading) {
+                    tap += bypass_mix * (audio - tap);
+                }
+                *tap_out[t]++ = denormal_fix(tap);
+            }
+        }
     }
+    x->bypass_mix = bypass_mix;
+    x->output_history[0] = history0;
+    x->output_history[1] = history1;
+    x->declick = declick;
+    x->declick_step = declick_step;
+    b->block_peak = block_peak;
 }
 
 //----------------------------------------------------------------------------------------------
 
-double ssm2044_process_sample(t_ssm2044 *x, double input, double cutoff, double resonance, double gain) {
-    // Compute filter coefficients for current cutoff and resonance
-    compute_filter_coefficients(x, cutoff, resonance);
-    
-    // Apply input gain with subtle saturation
-    double scaled_input = input * gain;
-    double saturated_input = soft_saturation(scaled_input, INPUT_DRIVE);
+SSM2044_KERNEL double ssm2044_cascade_kernel(t_ssm2044 *x, double saturated_input, double feedback_drive,
+                                             long table_feedback) {
+    // Coefficients (g, k) are computed by the caller for the current cutoff and resonance.
+    // The input arrives already gained and saturated (ssm2044_condition_block/_input).
+    // table_feedback is a literal per copy: 1 reads the shared tanh table instead of libm.
     
     // Zero-delay feedback calculation
     // For a 4-pole filter: y = G4 * (input + k * feedback)
@@ -267,8 +1433,11 @@ double ssm2044_process_sample(t_ssm2044 *x, double input, double cutoff, double
     
     // ZDF: solve for the feedback sample with feedback saturation
     // Saturate the feedback signal for more musical resonance
-    double saturated_feedback = soft_saturation(x->feedback_sample, FEEDBACK_DRIVE);
-    double fb_input = saturated_input + k * saturated_feedback;
+    double driven_feedback = x->feedback_sample * feedback_drive;
+    double saturated_feedback = (table_feedback ? table_tanh(driven_feedback) : tanh(driven_feedback))
+                              * (1.0 / feedback_drive);
+    double fb_input = saturated_input - k * saturated_feedback;
+    x->stage_input = fb_input;
     
     // Process through clean 4-pole cascade
     double stage1_out = x->state1 + g * (fb_input - x->state1);
@@ -290,103 +1459,1743 @@ double ssm2044_process_sample(t_ssm2044 *x, double input, double cutoff, double
 
 //----------------------------------------------------------------------------------------------
 
-void compute_filter_coefficients(t_ssm2044 *x, double cutoff, double resonance) {
-    // Clamp cutoff to valid range (avoid Nyquist issues)
-    cutoff = CLAMP(cutoff, 20.0, x->sr * 0.45);
-    
-    // Convert to angular frequency (radians per second)
-    double omega = 2.0 * PI * cutoff;
+SSM2044_KERNEL double ssm2044_ota_kernel(t_ssm2044 *x, double saturated_input, double feedback_drive) {
+    // ssm2044_cascade_kernel with every integrator driven through its OTA's transfer curve.
+    // All five curves (feedback + four stages) are reads of the shared tanh table.
+    double g = x->g;
+    double k = x->k;
     
-    // Apply bilinear transform pre-warping: 
-    // omega_warped = tan(omega * T/2) where T = 1/sr
-    double omega_warped = tan(omega * x->sr_inv * 0.5);
+    double saturated_feedback = table_tanh(feedback_drive * x->feedback_sample) * (1.0 / feedback_drive);
+    double fb_input = saturated_input - k * saturated_feedback;
+    x->stage_input = fb_input;
     
-    // Compute integrator gain (g) for one-pole section
-    // g = omega_warped / (1 + omega_warped)
-    x->g = omega_warped / (1.0 + omega_warped);
+    double stage1_out = x->state1 + g * ota_curve(fb_input - x->state1);
+    double stage2_out = x->state2 + g * ota_curve(stage1_out - x->state2);
+    double stage3_out = x->state3 + g * ota_curve(stage2_out - x->state3);
+    double stage4_out = x->state4 + g * ota_curve(stage3_out - x->state4);
     
-    // Clamp g to prevent instability (must be < 1.0)
-    x->g = CLAMP(x->g, 0.0, 0.99);
+    x->state1 = denormal_fix(stage1_out);
+    x->state2 = denormal_fix(stage2_out);
+    x->state3 = denormal_fix(stage3_out);
+    x->state4 = denormal_fix(stage4_out);
+    x->feedback_sample = stage4_out;
     
-    // Compute resonance feedback gain (k)
-    // Higher resonance = more feedback, approaching self-oscillation
-    x->k = resonance * RESONANCE_SCALE;
+    return stage4_out;
 }
 
 //----------------------------------------------------------------------------------------------
 
-double denormal_fix(double value) {
-    // Fix denormal numbers that can cause CPU spikes
-    if (fabs(value) < DENORMAL_THRESHOLD) {
-        return 0.0;
-    }
-    return value;
+double ota_curve(double input) {
+    // Differential pair transfer curve, unity slope at zero
+    return table_tanh(OTA_DRIVE * input) * (1.0 / OTA_DRIVE);
 }
 
 //----------------------------------------------------------------------------------------------
 
-double soft_saturation(double input, double drive) {
-    // Soft saturation using tanh function
-    // Provides musical harmonic distortion without harsh clipping
-    if (drive <= 0.0) return input;
+SSM2044_KERNEL double ssm2044_wdf_kernel(t_ssm2044 *x, double saturated_input, double feedback_drive) {
+    // Same inputs and outputs as ssm2044_cascade_kernel, computed as a wave digital filter
+    t_ssm2044_wdf *w = &x->wdf;
+    double *s = w->state;
     
-    double driven = input * drive;
+    // Scattering only changes with the coefficients
+    if (x->g != w->g || x->k != w->k) {
+        ssm2044_wdf_adapt(w, x->g, x->k);
+    }
     
-    // Apply tanh saturation for smooth, musical character
-    double saturated = tanh(driven);
+    // With the capacitor waves known, stage 4 is linear in the root voltage:
+    //   v4 = loop_gain * vin + open,  vin = input - k * tanh(d * v4) / d
+    double gamma = w->gamma;
+    double open = w->leak * (s[3] + gamma * (s[2] + gamma * (s[1] + gamma * s[0])));
+    double q = feedback_drive * (w->loop_gain * saturated_input + open);
+    double fb_input = saturated_input - x->k * ssm2044_wdf_root(q, w->root_c) * (1.0 / feedback_drive);
+    x->stage_input = fb_input;
     
-    // Compensate for drive level to maintain overall gain structure
-    return saturated / drive;
+    // Propagate the root wave down the stages: v = s + gamma * (vin - s), reflected wave 2v - s
+    double v1 = s[0] + gamma * (fb_input - s[0]);
+    double v2 = s[1] + gamma * (v1 - s[1]);
+    double v3 = s[2] + gamma * (v2 - s[2]);
+    double v4 = s[3] + gamma * (v3 - s[3]);
+    s[0] = denormal_fix(2.0 * v1 - s[0]);
+    s[1] = denormal_fix(2.0 * v2 - s[1]);
+    s[2] = denormal_fix(2.0 * v3 - s[2]);
+    s[3] = denormal_fix(2.0 * v4 - s[3]);
+    
+    // Capacitor voltages are the stage outputs seen by taps, morph and the stabilizer
+    x->state1 = v1;
+    x->state2 = v2;
+    x->state3 = v3;
+    x->state4 = v4;
+    x->feedback_sample = v4;
+    
+    return v4;
 }
 
 //----------------------------------------------------------------------------------------------
 
-void ssm2044_float(t_ssm2044 *x, double f) {
-    // lores~ pattern: proxy_getinlet works on signal inlets for float routing
-    long inlet = proxy_getinlet((t_object *)x);
-    
-    switch (inlet) {
-        case 1: // Cutoff frequency inlet
-            x->cutoff_float = CLAMP(f, 20.0, 20000.0);
-            break;
-        case 2: // Resonance inlet
-            x->resonance_float = CLAMP(f, 0.0, MAX_RESONANCE);
-            break;
-        case 3: // Input gain inlet
-            x->gain_float = CLAMP(f, 0.0, 4.0);
-            break;
-    }
+void ssm2044_wdf_adapt(t_ssm2044_wdf *w, double g, double k) {
+    // g is already the prewarped gamma = Rc / (R + Rc), so only the derived terms are needed
+    double g2 = g * g;
+    w->gamma = g;
+    w->leak = 1.0 - g;
+    w->loop_gain = g2 * g2;
+    w->root_c = w->loop_gain * k;
+    w->g = g;
+    w->k = k;
 }
 
 //----------------------------------------------------------------------------------------------
 
-void ssm2044_int(t_ssm2044 *x, long n) {
-    // lores~ pattern: proxy_getinlet works on signal inlets for int routing
-    long inlet = proxy_getinlet((t_object *)x);
-    
-    switch (inlet) {
-        case 1: // Cutoff frequency inlet - convert int to float
-            x->cutoff_float = CLAMP((double)n, 20.0, 20000.0);
-            break;
-        case 2: // Resonance inlet - convert int to float
-            x->resonance_float = CLAMP((double)n, 0.0, MAX_RESONANCE);
-            break;
-        case 3: // Input gain inlet - convert int to float
-            x->gain_float = CLAMP((double)n, 0.0, 4.0);
-            break;
+double ssm2044_wdf_root(double q, double c) {
+    // Solve y + c * tanh(y) = q and return tanh(y). The left side is monotonic, concave for
+    // y > 0 and convex for y < 0, so Newton from the small-signal solution approaches the
+    // root from one side without overshoot.
+    double y = q / (1.0 + c);
+    for (long i = 0; i < WDF_ROOT_ITERATIONS; i++) {
+        double t = table_tanh(y);
+        y -= (y + c * t - q) / (1.0 + c * (1.0 - t * t));
     }
+    return table_tanh(y);
 }
 
 //----------------------------------------------------------------------------------------------
 
-void ssm2044_assist(t_ssm2044 *x, void *b, long m, long a, char *s) {
-    if (m == ASSIST_INLET) {
-        switch (a) {
-            case 0:
-                sprintf(s, "(signal) Audio input");
-                break;
+SSM2044_KERNEL double ssm2044_dk_kernel(t_ssm2044 *x, double saturated_input, double feedback_drive) {
+    // Same inputs and outputs as ssm2044_cascade_kernel, computed by the DK state-space model
+    t_ssm2044_dk *dk = &x->dk;
+    t_ssm2044_dk_matrices *m = &dk->m;
+    double *s = dk->state;
+    double k = x->k;
+    
+    // Matrices only change with the cutoff: interpolate the two neighbouring table entries
+    if (dk->position != dk->position_key) {
+        long index = (long)dk->position;
+        if (index >= DK_TABLE_SIZE) {
+            index = DK_TABLE_SIZE - 1;
+        }
+        double frac = dk->position - index;
+        const double *lo = &ssm2044_dk_table[index].a[0][0];
+        const double *hi = &ssm2044_dk_table[index + 1].a[0][0];
+        double *dst = &m->a[0][0];
+        for (long i = 0; i < (long)(sizeof(t_ssm2044_dk_matrices) / sizeof(double)); i++) {
+            dst[i] = lo[i] + frac * (hi[i] - lo[i]);
+        }
+        dk->position_key = dk->position;
+    }
+    
+    // History term (A is lower triangular)
+    double p1 = m->a[0][0] * s[0] + m->c[0] * dk->ota_prev;
+    double p2 = m->a[1][0] * s[0] + m->a[1][1] * s[1] + m->c[1] * dk->ota_prev;
+    double p3 = m->a[2][0] * s[0] + m->a[2][1] * s[1] + m->a[2][2] * s[2] + m->c[2] * dk->ota_prev;
+    double p4 = m->a[3][0] * s[0] + m->a[3][1] * s[1] + m->a[3][2] * s[2] + m->a[3][3] * s[3]
+              + m->c[3] * dk->ota_prev;
+    
+    // The stage-1 OTA sees the whole feedback swing, k * fb: its drive eases off as k rises
+    // so self-oscillation stays in its near-linear range and on pitch, while loud input at
+    // low resonance still saturates it
+    double ota_gain = (1.0 + DK_OTA_EASE * k) * (1.0 / OTA_DRIVE);
+    double ota_drive = 1.0 / ota_gain;
+    
+    // Nonlinear ports: OTA input v1 = u - k * fb(v2) - x1[n], feedback node v2 = x4[n],
+    // with x1[n] = p1 + c1 * ota(v1) and x4[n] = p4 + c4 * ota(v1). Fixed-count 2x2 Newton.
+    double c1 = m->c[0];
+    double c4 = m->c[3];
+    double v1 = dk->v[0];
+    double v2 = dk->v[1];
+    double ota = 0.0;
+    double fb = 0.0;
+    for (long i = 0; i < DK_NEWTON_ITERATIONS; i++) {
+        double t1 = table_tanh(ota_drive * v1);
+        double t2 = table_tanh(feedback_drive * v2);
+        ota = t1 * ota_gain;
+        fb = t2 * (1.0 / feedback_drive);
+        double d1 = 1.0 - t1 * t1;
+        double d2 = 1.0 - t2 * t2;
+        
+        double r1 = v1 - (saturated_input - p1) + c1 * ota + k * fb;
+        double r2 = v2 - p4 - c4 * ota;
+        
+        // J = [1 + c1*d1, k*d2; -c4*d1, 1], always invertible (every term is non-negative)
+        double j11 = 1.0 + c1 * d1;
+        double j12 = k * d2;
+        double j21 = -c4 * d1;
+        double det_inv = 1.0 / (j11 - j12 * j21);
+        v1 -= (r1 - j12 * r2) * det_inv;
+        v2 -= (j11 * r2 - j21 * r1) * det_inv;
+    }
+    ota = table_tanh(ota_drive * v1) * ota_gain;
+    fb = table_tanh(feedback_drive * v2) * (1.0 / feedback_drive);
+    dk->v[0] = v1;
+    dk->v[1] = v2;
+    dk->ota_prev = ota;
+    
+    // State update from the solved OTA current
+    s[0] = denormal_fix(p1 + m->c[0] * ota);
+    s[1] = denormal_fix(p2 + m->c[1] * ota);
+    s[2] = denormal_fix(p3 + m->c[2] * ota);
+    s[3] = denormal_fix(p4 + m->c[3] * ota);
+    
+    x->stage_input = saturated_input - k * fb;
+    x->state1 = s[0];
+    x->state2 = s[1];
+    x->state3 = s[2];
+    x->state4 = s[3];
+    x->feedback_sample = s[3];
+    
+    return s[3];
+}
+
+//----------------------------------------------------------------------------------------------
+
+// One copy of every kernel per voicing, with the feedback drive as a literal
+#define SSM2044_DEFINE_KERNELS(name, input_drive, feedback_drive, resonance_scale, max_resonance) \
+    SSM2044_KERNEL double ssm2044_process_cascade_##name(t_ssm2044 *x, double saturated_input) { \
+        return ssm2044_cascade_kernel(x, saturated_input, feedback_drive, 0); \
+    } \
+    SSM2044_KERNEL double ssm2044_process_ota_##name(t_ssm2044 *x, double saturated_input) { \
+        return ssm2044_ota_kernel(x, saturated_input, feedback_drive); \
+    } \
+    SSM2044_KERNEL double ssm2044_process_wdf_##name(t_ssm2044 *x, double saturated_input) { \
+        return ssm2044_wdf_kernel(x, saturated_input, feedback_drive); \
+    } \
+    SSM2044_KERNEL double ssm2044_process_dk_##name(t_ssm2044 *x, double saturated_input) { \
+        return ssm2044_dk_kernel(x, saturated_input, feedback_drive); \
+    } \
+    SSM2044_KERNEL double ssm2044_process_cascade_table_##name(t_ssm2044 *x, double saturated_input) { \
+        return ssm2044_cascade_kernel(x, saturated_input, feedback_drive, 1); \
+    } \
+    void ssm2044_loop_cascade_##name(t_ssm2044 *x, t_ssm2044_block *b) { \
+        ssm2044_run_block(x, b, ssm2044_process_cascade_##name); \
+    } \
+    void ssm2044_loop_ota_##name(t_ssm2044 *x, t_ssm2044_block *b) { \
+        ssm2044_run_block(x, b, ssm2044_process_ota_##name); \
+    } \
+    void ssm2044_loop_wdf_##name(t_ssm2044 *x, t_ssm2044_block *b) { \
+        ssm2044_run_block(x, b, ssm2044_process_wdf_##name); \
+    } \
+    void ssm2044_loop_dk_##name(t_ssm2044 *x, t_ssm2044_block *b) { \
+        ssm2044_run_block(x, b, ssm2044_process_dk_##name); \
+    } \
+    void ssm2044_loop_cascade_table_##name(t_ssm2044 *x, t_ssm2044_block *b) { \
+        ssm2044_run_block(x, b, ssm2044_process_cascade_table_##name); \
+    }
+SSM2044_MODELS(SSM2044_DEFINE_KERNELS)
+
+//----------------------------------------------------------------------------------------------
+
+double ssm2044_cv_to_hz(const double *table, double volts) {
+    // Interpolated read of a dense CV table, held at 0 and 10 V
+    double position = volts * (CV_TABLE_SIZE / CV_TABLE_VOLTS);
+    position = CLAMP(position, 0.0, (double)CV_TABLE_SIZE);
+    long index = (long)position;
+    if (index >= CV_TABLE_SIZE) {
+        index = CV_TABLE_SIZE - 1;
+    }
+    double frac = position - index;
+    return table[index] + frac * (table[index + 1] - table[index]);
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_condition_frame(t_ssm2044 *x, double input, double gain, double *frame, long factor) {
+    // One input sample's worth of the block upsampler and conditioning, for blocks that run
+    // without a scratch slot. Same operations in the same order, so the same bits.
+    double prev = x->upsample_prev;
+    double delta = (input - prev) * (1.0 / factor);
+    for (long j = 1; j <= factor; j++) {
+        frame[j - 1] = prev + delta * j;
+    }
+    ssm2044_condition_block(x, frame, frame, &gain, 1, factor);
+    x->upsample_prev = input;
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_condition_block(t_ssm2044 *x, const double *src, double *dst, const double *gain_in,
+                             long sampleframes, long factor) {
+    // Apply input gain and saturation to a whole (oversampled) block. Every element is
+    // independent, so these loops vectorize instead of sitting in the feedback chain.
+    long total = sampleframes * factor;
+    double drive = ssm2044_voicings[x->model].input_drive;
+    
+    // Gain and drive in one multiply; signal gain is held across sub-samples
+    if (x->gain_has_signal) {
+        for (long i = 0; i < sampleframes; i++) {
+            double scale = CLAMP(gain_in[i], 0.0, 4.0) * drive;
+            for (long j = 0; j < factor; j++) {
+                dst[i * factor + j] = src[i * factor + j] * scale;
+            }
+        }
+    } else {
+        double scale = x->gain_float * drive;
+        for (long i = 0; i < total; i++) {
+            dst[i] = src[i] * scale;
+        }
+    }
+    
+    // Saturation curve on the driven signal: vForce on macOS, the shared table otherwise
+    // and always for @deterministic
+    if (x->saturation == SATURATION_ASYMMETRIC) {
+        for (long i = 0; i < total; i++) {
+            dst[i] = asymmetric_curve(dst[i]);
+        }
+    } else {
+        long vforce = 0;
+#ifdef MAC_VERSION
+        if (!x->deterministic) {
+            int count = (int)total;
+            vvtanh(dst, dst, &count);
+            vforce = 1;
+        }
+#endif
+        if (!vforce) {
+            // Elsewhere the shared tanh table: branch-free reads at about a quarter of the
+            // cost of libm tanh, and the same bits on every host
+            for (long i = 0; i < total; i++) {
+                dst[i] = table_tanh(dst[i]);
+            }
+        }
+    }
+    
+    // Undo the drive to keep the overall gain structure (as soft_saturation does)
+    double makeup = 1.0 / drive;
+    for (long i = 0; i < total; i++) {
+        dst[i] *= makeup;
+    }
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_perform_bypassed(t_ssm2044 *x, double *audio_in, double *out, double **tap_out,
+                              long taps, long sampleframes) {
+    // Idle bypass: a copy per outlet (nothing at all when Max runs us in place)
+    if (out != audio_in) {
+        memcpy(out, audio_in, sizeof(double) * sampleframes);
+    }
+    if (taps) {
+        for (long t = 0; t < TAP_OUTLETS; t++) {
+            if (tap_out[t] != audio_in) {
+                memcpy(tap_out[t], audio_in, sizeof(double) * sampleframes);
+            }
+        }
+    }
+    
+    if (x->bypass_mode == BYPASS_DECAY) {
+        double decay = x->rate.bypass_decay;
+        x->state1 = denormal_fix(x->state1 * decay);
+        x->state2 = denormal_fix(x->state2 * decay);
+        x->state3 = denormal_fix(x->state3 * decay);
+        x->state4 = denormal_fix(x->state4 * decay);
+        x->feedback_sample = x->state4;
+        for (long i = 0; i < 4; i++) {
+            x->wdf.state[i] = denormal_fix(x->wdf.state[i] * decay);
+            x->dk.state[i] = denormal_fix(x->dk.state[i] * decay);
+        }
+        x->dk.ota_prev = denormal_fix(x->dk.ota_prev * decay);
+    }
+}
+
+//----------------------------------------------------------------------------------------------
+
+t_max_err ssm2044_taps_attribute(t_ssm2044 *x, void *attr, long argc, t_atom *argv) {
+    // Outlets are made once in new: later changes are ignored so @taps always matches them
+    if (argc && argv && !x->outlets_created) {
+        x->taps = CLAMP(atom_getlong(argv), 0, 1);
+    }
+    return MAX_ERR_NONE;
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_compute_taps(t_ssm2044 *x, double *taps) {
+    // Mix the stage outputs of the last processed sample into the alternative responses
+    taps[TAP_LP6] = x->state1;
+    taps[TAP_LP12] = x->state2;
+    taps[TAP_LP18] = x->state3;
+    taps[TAP_BP] = 2.0 * (x->state1 - x->state2);
+    taps[TAP_HP] = x->stage_input - 2.0 * x->state1 + x->state2;
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_morph_weights(double morph, double *weights) {
+    // Interpolate between adjacent precomputed rows; morph is already clamped to 0-1
+    double position = morph * MORPH_TABLE_SIZE;
+    long index = (long)position;
+    if (index >= MORPH_TABLE_SIZE) {
+        index = MORPH_TABLE_SIZE - 1;
+    }
+    double frac = position - index;
+    const double *a = ssm2044_morph_table[index];
+    const double *b = ssm2044_morph_table[index + 1];
+    
+    for (long i = 0; i < MORPH_WEIGHTS; i++) {
+        weights[i] = a[i] + frac * (b[i] - a[i]);
+    }
+}
+
+//----------------------------------------------------------------------------------------------
+
+double ssm2044_morph_mix(t_ssm2044 *x, const double *weights) {
+    // Straight dot product over the stage vector, no branches
+    return weights[0] * x->stage_input
+         + weights[1] * x->state1
+         + weights[2] * x->state2
+         + weights[3] * x->state3
+         + weights[4] * x->state4;
+}
+
+//----------------------------------------------------------------------------------------------
+
+double compute_cutoff_coefficient(t_ssm2044 *x, double cutoff) {
+    // Integrator gain g for the current engine (the DK engine's table position instead)
+    // Clamp cutoff to valid range (avoid Nyquist issues)
+    cutoff = CLAMP(cutoff, 20.0, x->filter_sr * 0.45);
+    
+    if (x->active_engine == ENGINE_DK) {
+        // The DK engine reads its discretized matrices by normalized cutoff instead of g
+        return cutoff * (x->filter_sr_inv * (DK_TABLE_SIZE / 0.45));
+    } else if (x->tune && x->tune_table && x->active_engine == ENGINE_CASCADE) {
+        // Tuned mode: one interpolated read from the calibration table replaces the tan path
+        // (the wave digital engine is trapezoidal and lands on the cutoff without it)
+        double position = cutoff * x->tune_index_scale;
+        long index = (long)position;
+        if (index >= TUNE_TABLE_SIZE) {
+            index = TUNE_TABLE_SIZE - 1;
+        }
+        double frac = position - index;
+        return x->tune_table[index] + frac * (x->tune_table[index + 1] - x->tune_table[index]);
+    } else if (x->deterministic) {
+        // The FM pre-pass's quotient instead of libm tan, so every path agrees to the bit
+        return ssm2044_prewarp_gain(cutoff * (PI * x->filter_sr_inv));
+    } else {
+        // Convert to angular frequency (radians per second)
+        double omega = 2.0 * PI * cutoff;
+        
+        // Apply bilinear transform pre-warping: 
+        // omega_warped = tan(omega * T/2) where T = 1/(sr * oversampling)
+        double omega_warped = tan(omega * x->filter_sr_inv * 0.5);
+        
+        // Compute integrator gain (g) for one-pole section
+        // g = omega_warped / (1 + omega_warped)
+        double g = omega_warped / (1.0 + omega_warped);
+        
+        // Clamp g to prevent instability (must be < 1.0)
+        return CLAMP(g, 0.0, 0.99);
+    }
+    
+}
+
+//----------------------------------------------------------------------------------------------
+
+double ssm2044_cutoff_hz(double raw, double fm, const double *cv_table) {
+    // Cutoff inlet value (Hz, or volts with a CV curve) plus linear FM, in Hz
+    double cutoff = cv_table ? ssm2044_cv_to_hz(cv_table, raw) : raw;
+    return CLAMP(cutoff, 20.0, 20000.0) + fm;
+}
+
+//----------------------------------------------------------------------------------------------
+
+long ssm2044_coefficient_interval(t_ssm2044 *x, const double *cutoff_in, const double *cv_table,
+                                  long sampleframes) {
+    // Largest power-of-two interval whose worst-case cutoff change (steepest first difference
+    // in this block, relative to the cutoff) stays under COEFF_MOTION_LIMIT. Float cutoffs
+    // only change between blocks, so they always get the longest interval.
+    if (x->fm_has_signal) {
+        return 1;       // FM without a pre-pass buffer: every sample
+    }
+    if (!x->cutoff_has_signal) {
+        return COEFF_INTERVAL_MAX;
+    }
+    
+    double prev = x->cutoff_prev;
+    double max_delta = 0.0;
+    double min_value = cutoff_in[0];
+    for (long i = 0; i < sampleframes; i++) {
+        double delta = fabs(cutoff_in[i] - prev);
+        max_delta = (delta > max_delta) ? delta : max_delta;
+        min_value = (cutoff_in[i] < min_value) ? cutoff_in[i] : min_value;
+        prev = cutoff_in[i];
+    }
+    
+    // With a CV curve the inlet is in volts, about ln 2 of relative change per volt
+    double motion = cv_table ? max_delta * 0.6931 : max_delta / ((min_value > 20.0) ? min_value : 20.0);
+    
+    long interval = COEFF_INTERVAL_MAX;
+    while (interval > 1 && interval * motion > COEFF_MOTION_LIMIT) {
+        interval >>= 1;
+    }
+    return interval;
+}
+
+//----------------------------------------------------------------------------------------------
+
+void compute_resonance_coefficients(t_ssm2044 *x, double resonance) {
+    // Resonance-dependent terms only change when resonance does
+    if (resonance != x->coeff_resonance) {
+        x->coeff_resonance = resonance;
+        
+        // Compute resonance feedback gain (k)
+        // Higher resonance = more feedback, approaching self-oscillation
+        double k = resonance * ssm2044_voicings[x->model].resonance_scale;
+        x->k = k;
+        
+        // Upward crossing of the oscillation threshold schedules a kick
+        if (x->kick_mode != KICK_OFF && k > SELF_OSC_K && x->kick_prev_k <= SELF_OSC_K) {
+            ssm2044_post_kick(x, x->kick_mode);
+        }
+        if (k <= SELF_OSC_K) {
+            x->kick_step = 0.0;     // A held step ends when the filter drops out of oscillation
+        }
+        x->kick_prev_k = k;
+        
+        // Stabilizer only trims the part of k that drives self-oscillation
+        if (x->stabilize && k > SELF_OSC_K) {
+            x->k = SELF_OSC_K + (k - SELF_OSC_K) * x->stabilize_trim;
+        }
+        
+        // Compensation gain for the passband drop caused by the negative feedback
+        switch (x->compensation) {
+            case COMPENSATION_MUSICAL:
+                x->output_gain = 1.0 + resonance * 0.5;
+                break;
+            case COMPENSATION_FULL:
+                x->output_gain = 1.0 + k;
+                break;
+            default:
+                x->output_gain = 1.0;
+                break;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_fm_coefficients(t_ssm2044 *x, const double *cutoff_in, const double *fm_in,
+                             const double *cv_table, double *coeffs, long sampleframes) {
+    // Cutoff coefficients for a whole block under audio-rate FM: first the summed cutoff,
+    // then the coefficient in a loop with no calls or branches the compiler can't vectorize
+    double limit = x->filter_sr * 0.45;
+    
+    for (long i = 0; i < sampleframes; i++) {
+        double cutoff = ssm2044_cutoff_hz(x->cutoff_has_signal ? cutoff_in[i] : x->cutoff_float,
+                                          fm_in[i], cv_table);
+        coeffs[i] = CLAMP(cutoff, 20.0, limit);
+    }
+    
+    if (x->active_engine == ENGINE_DK) {
+        double scale = x->filter_sr_inv * (DK_TABLE_SIZE / 0.45);
+        for (long i = 0; i < sampleframes; i++) {
+            coeffs[i] *= scale;
+        }
+    } else if (x->tune && x->tune_table && x->active_engine == ENGINE_CASCADE) {
+        for (long i = 0; i < sampleframes; i++) {
+            double position = coeffs[i] * x->tune_index_scale;
+            long index = (long)position;
+            if (index >= TUNE_TABLE_SIZE) {
+                index = TUNE_TABLE_SIZE - 1;
+            }
+            double frac = position - index;
+            coeffs[i] = x->tune_table[index] + frac * (x->tune_table[index + 1] - x->tune_table[index]);
+        }
+    } else {
+        double w_scale = PI * x->filter_sr_inv;
+        for (long i = 0; i < sampleframes; i++) {
+            coeffs[i] = ssm2044_prewarp_gain(coeffs[i] * w_scale);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------
+
+SSM2044_KERNEL double ssm2044_prewarp_gain(double w) {
+    // g = t / (1 + t) with t = tan(w), w = pi * f / fs, as a [5/4] Pade quotient N / D, so
+    // g = N / (N + D): one division, no tan. D > 0 up to 0.5 * pi and the cutoff stops at
+    // 0.45 * pi, so g stays inside (0, 1) however fast the cutoff moves. Matches the tan
+    // path to a few parts per million. Inlined so the FM pre-pass loop still vectorizes.
+    double w2 = w * w;
+    double num = w * (945.0 + w2 * (w2 - 105.0));
+    double den = 945.0 + w2 * (15.0 * w2 - 420.0);
+    double g = num / (num + den);
+    return (g < 0.99) ? g : 0.99;
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_stabilizer_update(t_ssm2044 *x, double block_peak, long sampleframes) {
+    // Peak-hold follower with exponential release, then nudge the k trim toward the target
+    double block_time = sampleframes * x->sr_inv;
+    double release = ssm2044_exp(-block_time / STABILIZER_RELEASE);
+    double env = x->stabilize_env * release;
+    env = (block_peak > env) ? block_peak : env;
+    x->stabilize_env = env;
+    
+    double error = (x->stabilize_level - env) / x->stabilize_level;
+    double trim = x->stabilize_trim + error * (block_time / STABILIZER_TIME);
+    trim = CLAMP(trim, 0.0, 1.0);
+    
+    if (trim != x->stabilize_trim) {
+        x->stabilize_trim = trim;
+        x->coeff_resonance = -1.0;      // Apply the new trim on the next coefficient update
+    }
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_kick(t_ssm2044 *x) {
+    // Picked up by the audio thread before the next sample
+    ssm2044_post_kick(x, (x->kick_mode == KICK_STEP) ? KICK_STEP : KICK_IMPULSE);
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_post_kick(t_ssm2044 *x, long shape) {
+    // Posted from the main thread (kick) and the audio thread (threshold crossing)
+    t_int32_atomic pending;
+    do {
+        pending = x->kick_pending;
+    } while (!ATOMIC_COMPARE_SWAP32(pending, (t_int32_atomic)shape, &x->kick_pending));
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_apply_kick(t_ssm2044 *x, long shape) {
+    // Step: a DC offset on the stage-1 input, which reaches the output through all four
+    // poles. Held while the filter oscillates; below the threshold it falls back to the
+    // impulse, since a held step would just be an output offset.
+    if (shape == KICK_STEP && x->kick_prev_k > SELF_OSC_K) {
+        x->kick_step = x->kick_amount;
+        return;
+    }
+    
+    // Impulse: one-sample kick to the stage-1 state
+    if (x->active_engine == ENGINE_WDF) {
+        x->wdf.state[0] += x->kick_amount;     // The wave engine keeps its memory in the waves
+    } else if (x->active_engine == ENGINE_DK) {
+        x->dk.state[0] += x->kick_amount;
+    } else {
+        x->state1 += x->kick_amount;
+    }
+}
+
+//----------------------------------------------------------------------------------------------
+
+t_max_err ssm2044_compensation_attribute(t_ssm2044 *x, void *attr, long argc, t_atom *argv) {
+    if (argc && argv) {
+        x->compensation = CLAMP(atom_getlong(argv), COMPENSATION_OFF, COMPENSATION_FULL);
+        x->coeff_resonance = -1.0;      // Recompute the gain on the next sample
+    }
+    return MAX_ERR_NONE;
+}
+
+//----------------------------------------------------------------------------------------------
+
+t_max_err ssm2044_engine_attribute(t_ssm2044 *x, void *attr, long argc, t_atom *argv) {
+    if (argc && argv) {
+        // Perform seeds the new engine's state on its next block
+        x->engine = CLAMP(atom_getlong(argv), ENGINE_CASCADE, ENGINE_DK);
+    }
+    return MAX_ERR_NONE;
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_seed_engine(t_ssm2044 *x, long engine) {
+    // Every engine publishes its stage voltages in state1..4, so the new one
+    // starts from them to switch without a click
+    if (engine == ENGINE_WDF) {
+        // A settled capacitor reflects its own voltage
+        x->wdf.state[0] = x->state1;
+        x->wdf.state[1] = x->state2;
+        x->wdf.state[2] = x->state3;
+        x->wdf.state[3] = x->state4;
+    } else if (engine == ENGINE_DK) {
+        x->dk.state[0] = x->state1;
+        x->dk.state[1] = x->state2;
+        x->dk.state[2] = x->state3;
+        x->dk.state[3] = x->state4;
+        x->dk.ota_prev = 0.0;
+        x->dk.v[0] = 0.0;
+        x->dk.v[1] = x->state4;
+    }
+}
+
+//----------------------------------------------------------------------------------------------
+
+t_max_err ssm2044_budget_attribute(t_ssm2044 *x, void *attr, long argc, t_atom *argv) {
+    if (argc && argv) {
+        // A new budget starts over from full quality
+        x->budget = CLAMP(atom_getfloat(argv), 0.0, 100.0);
+        x->quality = QUALITY_FULL;
+        x->load_share = 0.0;
+        x->watchdog_over = 0;
+        x->watchdog_calm = 0.0;
+        x->watchdog_recover = WATCHDOG_RECOVER_TIME;
+        x->watchdog_stepped_up = 0;
+    }
+    return MAX_ERR_NONE;
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_watchdog_update(t_ssm2044 *x, long sampleframes) {
+    // Load relative to the budget: 1.0 = the block used exactly its share of real time
+    double block_seconds = sampleframes * x->sr_inv;
+    double load = x->load_share / (x->budget * 0.01);
+    
+    if (load > 1.0) {
+        // Over budget for several blocks in a row: one tier cheaper
+        x->watchdog_calm = 0.0;
+        if (++x->watchdog_over >= WATCHDOG_OVER_BLOCKS && x->quality < QUALITY_TIERS - 1) {
+            if (x->watchdog_stepped_up) {
+                // The last step up didn't fit: wait longer before the next try
+                x->watchdog_recover *= 2.0;
+                if (x->watchdog_recover > WATCHDOG_RECOVER_MAX) {
+                    x->watchdog_recover = WATCHDOG_RECOVER_MAX;
+                }
+            }
+            x->quality++;
+            x->watchdog_over = 0;
+            x->watchdog_stepped_up = 0;
+        }
+    } else {
+        x->watchdog_over = 0;
+        if (load < WATCHDOG_HEADROOM && x->quality > QUALITY_FULL) {
+            // Plenty of headroom for long enough: one tier better
+            x->watchdog_calm += block_seconds;
+            if (x->watchdog_calm >= x->watchdog_recover) {
+                x->quality--;
+                x->watchdog_calm = 0.0;
+                x->watchdog_stepped_up = 1;
+            }
+        } else {
+            x->watchdog_calm = 0.0;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_totalbudget(t_ssm2044 *x, double budget) {
+    // Shared by every instance: any of them can set it
+    ssm2044_total_budget = CLAMP(budget, 0.0, 100.0);
+    
+    if (ssm2044_total_budget > 0.0) {
+        if (!ssm2044_coordinator_clock) {
+            ssm2044_coordinator_clock = clock_new(NULL, (method)ssm2044_coordinate);
+        }
+        clock_fdelay(ssm2044_coordinator_clock, COORDINATOR_INTERVAL);
+    } else {
+        // Off: stop the coordinator and put everyone back to full quality
+        if (ssm2044_coordinator_clock) {
+            clock_unset(ssm2044_coordinator_clock);
+        }
+        critical_enter(0);
+        for (t_ssm2044 *i = ssm2044_instances; i; i = i->next_instance) {
+            i->shed = QUALITY_FULL;
+        }
+        critical_exit(0);
+    }
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_coordinate(void *unused) {
+    // One pass over all instances. Over budget: shed tiers from the lowest priority up
+    // (costliest first within a priority) until the estimated total fits. Well under
+    // budget: give one tier back, highest priority first, and measure again next pass.
+    // Stops rescheduling itself once the budget is off or no instance is left.
+    if (ssm2044_total_budget <= 0.0) {
+        return;
+    }
+    
+    double now = systimer_gettime();
+    double budget = ssm2044_total_budget * 0.01;
+    double total = 0.0;
+    
+    critical_enter(0);
+    if (!ssm2044_instances) {
+        critical_exit(0);
+        return;
+    }
+    for (t_ssm2044 *i = ssm2044_instances; i; i = i->next_instance) {
+        i->coordinator_share = (now - i->load_time < COORDINATOR_STALE) ? i->load_share : 0.0;
+        total += i->coordinator_share;
+    }
+    
+    if (total > budget) {
+        while (total > budget) {
+            t_ssm2044 *victim = NULL;
+            for (t_ssm2044 *i = ssm2044_instances; i; i = i->next_instance) {
+                if (i->shed >= QUALITY_TIERS - 1 || i->coordinator_share <= 0.0 || i->deterministic) {
+                    continue;
+                }
+                if (!victim || i->priority < victim->priority
+                    || (i->priority == victim->priority && i->coordinator_share > victim->coordinator_share)) {
+                    victim = i;
+                }
+            }
+            if (!victim) {
+                break;      // Everyone already at the cheapest tier
+            }
+            victim->shed++;
+            total -= victim->coordinator_share * COORDINATOR_STEP_SAVING;
+            victim->coordinator_share *= 1.0 - COORDINATOR_STEP_SAVING;
+        }
+    } else if (total < budget * COORDINATOR_HEADROOM) {
+        t_ssm2044 *lucky = NULL;
+        for (t_ssm2044 *i = ssm2044_instances; i; i = i->next_instance) {
+            if (i->shed > QUALITY_FULL && (!lucky || i->priority > lucky->priority)) {
+                lucky = i;
+            }
+        }
+        if (lucky) {
+            lucky->shed--;
+        }
+    }
+    
+    // Rescheduled inside the region, so free cannot release the clock in between
+    clock_fdelay(ssm2044_coordinator_clock, COORDINATOR_INTERVAL);
+    critical_exit(0);
+}
+
+//----------------------------------------------------------------------------------------------
+
+long ssm2044_kernel_index(t_ssm2044 *x, long engine) {
+    switch (engine) {
+        case ENGINE_WDF:
+            return KERNEL_WDF;
+        case ENGINE_DK:
+            return KERNEL_DK;
+        default:
+            if (x->stage_saturation) {
+                return KERNEL_OTA;
+            }
+            return x->deterministic ? KERNEL_CASCADE_TABLE : KERNEL_CASCADE;
+    }
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_cost(t_ssm2044 *x, long voices) {
+    // Predicted cost of the current settings, for budgeting poly~ voices ahead of time
+    voices = (voices < 1) ? 1 : voices;
+    double ns = ssm2044_predict_cost(x);
+    double core = ns * voices * x->sr * 1e-7;   // Percent of one core at the host rate
+    
+    object_post((t_object *)x, "cost: %.1f ns/sample per voice, %ld voice%s = %.2f%% of one core at %.0f Hz",
+                ns, voices, (voices == 1) ? "" : "s", core, x->sr);
+}
+
+//----------------------------------------------------------------------------------------------
+
+t_max_err ssm2044_cost_get(t_ssm2044 *x, void *attr, long *argc, t_atom **argv) {
+    char alloc;
+    
+    x->cost = ssm2044_predict_cost(x);
+    atom_alloc(argc, argv, &alloc);
+    atom_setfloat(*argv, x->cost);
+    return MAX_ERR_NONE;
+}
+
+//----------------------------------------------------------------------------------------------
+
+double ssm2044_predict_cost(t_ssm2044 *x) {
+    // Sum of the measured components perform will run for the current inlet connections,
+    // attributes and quality tier, in ns per host sample
+    const t_ssm2044_costs *c = &ssm2044_costs;
+    if (!c->ready) {
+        ssm2044_calibrate_costs();
+    }
+    
+    if (x->bypass && x->bypass_mix >= 1.0) {
+        return c->output;       // Fully bypassed: a copy
+    }
+    
+    long quality = (x->shed > x->quality) ? x->shed : x->quality;
+    quality = x->deterministic ? QUALITY_FULL : quality;
+    long factor = (quality >= QUALITY_BASE_RATE) ? 1 : x->oversample_factor;
+    long engine = (quality >= QUALITY_CASCADE) ? ENGINE_CASCADE : x->engine;
+    long outlets = x->taps ? 1 + TAP_OUTLETS : 1;     // As created (@taps is fixed after new)
+    
+    double condition = (x->saturation == SATURATION_ASYMMETRIC) ? c->condition_asymmetric : c->condition;
+    double ns = factor * (c->kernel[ssm2044_kernel_index(x, engine)] + condition);
+    ns += outlets * c->output;
+    if (factor > 1) {
+        ns += outlets * c->decimate[factor];
+    }
+    if (x->taps) {
+        ns += factor * c->taps;
+    }
+    if (x->dcblock) {
+        ns += outlets * c->dcblock;
+    }
+    if (x->limit) {
+        ns += outlets * c->limit;
+    }
+    if (x->morph_has_signal || x->morph_float > 0.0) {
+        ns += factor * c->morph;
+    }
+    
+    // Cutoff coefficients: per sample under the FM pre-pass, else at the interval the last
+    // block picked (a float cutoff is one update per COEFF_INTERVAL_MAX samples)
+    if (x->fm_has_signal && quality < QUALITY_DECIMATED) {
+        ns += c->coefficient;
+    } else if (x->cutoff_has_signal || x->fm_has_signal) {
+        long interval = (quality >= QUALITY_DECIMATED) ? COEFF_INTERVAL_MAX : x->coeff_interval;
+        ns += c->coefficient / ((interval > 0) ? interval : 1);
+    } else {
+        ns += c->coefficient / COEFF_INTERVAL_MAX;
+    }
+    return ns;
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_calibrate_costs(void) {
+    // Main thread only. Times each component on a private instance, best of a few runs,
+    // so predictions reflect this machine. Takes a few tens of milliseconds once.
+    t_ssm2044_costs *c = &ssm2044_costs;
+    t_ssm2044 *b = (t_ssm2044 *)sysmem_newptrclear(sizeof(t_ssm2044));
+    double *input = (double *)sysmem_newptr(CALIBRATION_FRAMES * sizeof(double));
+    double *output = (double *)sysmem_newptr(CALIBRATION_FRAMES * sizeof(double));
+    if (!b || !input || !output) {
+        sysmem_freeptr(b);
+        sysmem_freeptr(input);
+        sysmem_freeptr(output);
+        return;
+    }
+    
+    ssm2044_prepare_shared_tables();
+    for (long i = 0; i < CALIBRATION_FRAMES; i++) {
+        input[i] = 0.5 * sin(i * 0.05);
+    }
+    
+    // A resonant 1 kHz filter at 48 kHz
+    b->filter_sr = 48000.0;
+    b->filter_sr_inv = 1.0 / b->filter_sr;
+    b->gain_float = 1.0;
+    b->g = compute_cutoff_coefficient(b, 1000.0);
+    b->k = 2.0;
+    b->wdf.g = -1.0;
+    b->dk.position = 1000.0 * b->filter_sr_inv * (DK_TABLE_SIZE / 0.45);
+    b->dk.position_key = -1.0;
+    
+    for (long k = 0; k < KERNELS; k++) {
+        c->kernel[k] = 0.0;
+    }
+    c->condition = c->condition_asymmetric = c->coefficient = c->morph = c->output = 0.0;
+    c->dcblock = c->limit = c->taps = 0.0;
+    for (long f = 0; f <= MAX_OVERSAMPLE; f++) {
+        c->decimate[f] = 0.0;
+    }
+    
+    double ns_per = 1e6 / CALIBRATION_FRAMES;   // ms per run -> ns per sample
+    for (long run = 0; run < CALIBRATION_RUNS; run++) {
+        double sink = 0.0;
+        double t;
+        
+        // Filter kernels (the SSM2044 voicing; the others differ only in constants)
+        for (long k = 0; k < KERNELS; k++) {
+            t_ssm2044_kernel process = ssm2044_kernels[MODEL_SSM2044][k];
+            t = systimer_gettime();
+            for (long i = 0; i < CALIBRATION_FRAMES; i++) {
+                sink += process(b, input[i]);
+            }
+            t = (systimer_gettime() - t) * ns_per;
+            c->kernel[k] = (run == 0 || t < c->kernel[k]) ? t : c->kernel[k];
+        }
+        
+        // Input conditioning block pass, with each saturation curve
+        b->saturation = SATURATION_SYMMETRIC;
+        t = systimer_gettime();
+        ssm2044_condition_block(b, input, output, NULL, CALIBRATION_FRAMES, 1);
+        sink += output[CALIBRATION_FRAMES - 1];
+        t = (systimer_gettime() - t) * ns_per;
+        c->condition = (run == 0 || t < c->condition) ? t : c->condition;
+        
+        b->saturation = SATURATION_ASYMMETRIC;
+        t = systimer_gettime();
+        ssm2044_condition_block(b, input, output, NULL, CALIBRATION_FRAMES, 1);
+        sink += output[CALIBRATION_FRAMES - 1];
+        t = (systimer_gettime() - t) * ns_per;
+        c->condition_asymmetric = (run == 0 || t < c->condition_asymmetric) ? t : c->condition_asymmetric;
+        b->saturation = SATURATION_SYMMETRIC;
+        
+        // Decimators: one push per host sample at each factor
+        for (long f = 2; f <= MAX_OVERSAMPLE; f++) {
+            long frames = CALIBRATION_FRAMES / f;
+            ssm2044_decimator_reset(&b->decimator);
+            t = systimer_gettime();
+            for (long i = 0; i < frames; i++) {
+                sink += ssm2044_decimator_push(&b->decimator, input + i * f, f);
+            }
+            t = (systimer_gettime() - t) * 1e6 / frames;
+            c->decimate[f] = (run == 0 || t < c->decimate[f]) ? t : c->decimate[f];
+        }
+        
+        // Exact cutoff coefficient (tan prewarp)
+        t = systimer_gettime();
+        for (long i = 0; i < CALIBRATION_FRAMES; i++) {
+            sink += compute_cutoff_coefficient(b, 1000.0 + 500.0 * input[i]);
+        }
+        t = (systimer_gettime() - t) * ns_per;
+        c->coefficient = (run == 0 || t < c->coefficient) ? t : c->coefficient;
+        
+        // Morph weights and mix
+        t = systimer_gettime();
+        for (long i = 0; i < CALIBRATION_FRAMES; i++) {
+            double weights[MORPH_WEIGHTS];
+            ssm2044_morph_weights(0.5 + input[i], weights);
+            b->state1 = input[i];
+            sink += ssm2044_morph_mix(b, weights);
+        }
+        t = (systimer_gettime() - t) * ns_per;
+        c->morph = (run == 0 || t < c->morph) ? t : c->morph;
+        
+        // Output stage: compensation gain, denormal fix and store
+        t = systimer_gettime();
+        for (long i = 0; i < CALIBRATION_FRAMES; i++) {
+            output[i] = denormal_fix(input[i] * b->gain_float);
+        }
+        sink += output[CALIBRATION_FRAMES - 1];
+        t = (systimer_gettime() - t) * ns_per;
+        c->output = (run == 0 || t < c->output) ? t : c->output;
+        
+        // DC blocker, one per outlet side by side as in perform (its recursion overlaps)
+        t = systimer_gettime();
+        for (long i = 0; i < CALIBRATION_FRAMES; i++) {
+            for (long o = 0; o < 1 + TAP_OUTLETS; o++) {
+                sink += ssm2044_dc_block(&b->dcblockers[o], input[i], 0.995);
+            }
+        }
+        t = (systimer_gettime() - t) * ns_per / (1 + TAP_OUTLETS);
+        c->dcblock = (run == 0 || t < c->dcblock) ? t : c->dcblock;
+        
+        // Soft limiter, driven past its knee
+        t = systimer_gettime();
+        for (long i = 0; i < CALIBRATION_FRAMES; i++) {
+            sink += soft_limit(2.0 * input[i]);
+        }
+        t = (systimer_gettime() - t) * ns_per;
+        c->limit = (run == 0 || t < c->limit) ? t : c->limit;
+        
+        // Tap outputs from the stage states
+        t = systimer_gettime();
+        for (long i = 0; i < CALIBRATION_FRAMES; i++) {
+            double frame[TAP_OUTLETS];
+            b->state1 = input[i];
+            ssm2044_compute_taps(b, frame);
+            sink += frame[TAP_HP];
+        }
+        t = (systimer_gettime() - t) * ns_per;
+        c->taps = (run == 0 || t < c->taps) ? t : c->taps;
+        
+        ssm2044_calibration_sink = sink;
+    }
+    
+    sysmem_freeptr(output);
+    sysmem_freeptr(input);
+    sysmem_freeptr(b);
+    c->ready = 1;
+}
+
+//----------------------------------------------------------------------------------------------
+
+t_max_err ssm2044_model_attribute(t_ssm2044 *x, void *attr, long argc, t_atom *argv) {
+    if (argc && argv) {
+        x->model = CLAMP(atom_getlong(argv), MODEL_SSM2044, MODELS - 1);
+        x->coeff_resonance = -1.0;      // New resonance scale on the next sample
+    }
+    return MAX_ERR_NONE;
+}
+
+//----------------------------------------------------------------------------------------------
+
+double denormal_fix(double value) {
+    // Fix denormal numbers that can cause CPU spikes
+    if (fabs(value) < DENORMAL_THRESHOLD) {
+        return 0.0;
+    }
+    return value;
+}
+
+//----------------------------------------------------------------------------------------------
+
+#if SSM2044_RT_CHECK
+void ssm2044_rt_check(const char *call) {
+    // Every heap allocation and free in the process lands here (SSM2044_RT_CHECK builds)
+    if (ssm2044_in_perform) {
+        ssm2044_in_perform = 0;     // post may allocate itself
+        post("ssm2044~: %s on the audio thread", call);
+        abort();
+    }
+}
+
+#ifdef MAC_VERSION
+// macOS: libmalloc calls malloc_logger after every allocation and free in every zone (the
+// hook behind MallocStackLogging), so it sees the whole process without patching zones
+typedef void (ssm2044_malloc_logger_t)(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3,
+                                       uintptr_t result, uint32_t num_hot_frames_to_skip);
+extern ssm2044_malloc_logger_t *malloc_logger;
+static ssm2044_malloc_logger_t *ssm2044_rt_previous_logger = NULL;
+
+static void ssm2044_rt_logger(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3,
+                              uintptr_t result, uint32_t num_hot_frames_to_skip) {
+    if (ssm2044_rt_previous_logger) {
+        ssm2044_rt_previous_logger(type, arg1, arg2, arg3, result, num_hot_frames_to_skip + 1);
+    }
+    if (type & 2) {             // MALLOC_LOG_TYPE_ALLOCATE (also set for realloc)
+        ssm2044_rt_check("heap allocation");
+    } else if (type & 4) {      // MALLOC_LOG_TYPE_DEALLOCATE
+        ssm2044_rt_check("heap free");
+    }
+}
+
+void ssm2044_rt_install(void) {
+    // Once per process, chained in front of any logger already installed
+    if (malloc_logger != ssm2044_rt_logger) {
+        ssm2044_rt_previous_logger = malloc_logger;
+        malloc_logger = ssm2044_rt_logger;
+    }
+}
+#else
+// Elsewhere (glibc): these definitions replace the C library's allocator for every caller
+// when the module is preloaded (LD_PRELOAD) or linked into the host, and forward to it
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void __libc_free(void *ptr);
+
+void *malloc(size_t size) {
+    ssm2044_rt_check("malloc");
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+    ssm2044_rt_check("calloc");
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    ssm2044_rt_check("realloc");
+    return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr) {
+    ssm2044_rt_check("free");
+    __libc_free(ptr);
+}
+
+void ssm2044_rt_install(void) {
+    // Nothing to install: the symbols above are the hook
+}
+#endif
+#endif
+
+//----------------------------------------------------------------------------------------------
+
+double soft_saturation(double input, double drive) {
+    // Soft saturation using tanh function
+    // Provides musical harmonic distortion without harsh clipping
+    if (drive <= 0.0) return input;
+    
+    double driven = input * drive;
+    
+    // Apply tanh saturation for smooth, musical character
+    double saturated = tanh(driven);
+    
+    // Compensate for drive level to maintain overall gain structure
+    return saturated / drive;
+}
+
+//----------------------------------------------------------------------------------------------
+
+double asymmetric_saturation(double input, double drive) {
+    // Same structure as soft_saturation, with the curve read from the shared table
+    return asymmetric_curve(input * drive) / drive;
+}
+
+//----------------------------------------------------------------------------------------------
+
+double asymmetric_curve(double driven) {
+    // Interpolated read of tanh(u) + 0.05 * tanh(u/2)^2, clamped outside the table
+    double position = (driven * (1.0 / SATURATION_TABLE_RANGE) + 1.0) * (0.5 * SATURATION_TABLE_SIZE);
+    if (position <= 0.0) return ssm2044_saturation_table[0];
+    if (position >= SATURATION_TABLE_SIZE) return ssm2044_saturation_table[SATURATION_TABLE_SIZE];
+    
+    long index = (long)position;
+    double frac = position - index;
+    return ssm2044_saturation_table[index]
+        + frac * (ssm2044_saturation_table[index + 1] - ssm2044_saturation_table[index]);
+}
+
+//----------------------------------------------------------------------------------------------
+
+double table_tanh(double u) {
+    // Interpolated read of the shared tanh table, held at the end values outside it. This
+    // sits in feedback chains, so it is kept short: predictable clamp, one row per read.
+    double position = u * (0.5 * TANH_TABLE_SIZE / TANH_TABLE_RANGE) + 0.5 * TANH_TABLE_SIZE;
+    position = (position > 0.0) ? position : 0.0;
+    position = (position < TANH_TABLE_SIZE) ? position : TANH_TABLE_SIZE;
+    
+    long index = (long)position;
+    const double *row = ssm2044_tanh_table[index];
+    return row[0] + (position - index) * row[1];
+}
+
+//----------------------------------------------------------------------------------------------
+
+double soft_limit(double input) {
+    // Cubic soft clip: unity slope at zero, reaches +-1.0 smoothly at +-LIMIT_KNEE
+    double u = input * (1.0 / LIMIT_KNEE);
+    if (u >= 1.0) return 1.0;
+    if (u <= -1.0) return -1.0;
+    return LIMIT_KNEE * (u - u * u * u * (1.0 / 3.0));
+}
+
+//----------------------------------------------------------------------------------------------
+
+double ssm2044_dc_block(t_ssm2044_dcblocker *dc, double input, double coeff) {
+    // y[n] = x[n] - x[n-1] + R * y[n-1]
+    double output = input - dc->x1 + coeff * dc->y1;
+    dc->x1 = input;
+    dc->y1 = denormal_fix(output);
+    return output;
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_update_rate_cache(t_ssm2044 *x, double samplerate, long maxvectorsize) {
+    // Main thread only (dsp64). Covers every oversampling factor, so @oversample changes
+    // only store the request and perform switches rates at the top of a block.
+    t_ssm2044_rate_cache *cache = &x->rate;
+    
+    if (cache->samplerate == samplerate && cache->maxvectorsize == maxvectorsize) {
+        return;
+    }
+    
+    // Resampler histories only mean something at the rate they were recorded at
+    if (cache->samplerate != samplerate) {
+        x->upsample_prev = 0.0;
+        ssm2044_decimator_reset(&x->decimator);
+        for (long i = 0; i < TAP_OUTLETS; i++) {
+            ssm2044_decimator_reset(&x->tap_decimators[i]);
+        }
+    }
+    
+    x->sr = samplerate;
+    x->sr_inv = 1.0 / samplerate;
+    x->maxvectorsize = maxvectorsize;
+    
+    // Processing rates and shared pitch calibration for every factor perform may run at.
+    // The new tables are taken before the old ones are dropped, so a table the previous
+    // chain may still be reading is never rebuilt for this instance's new rate.
+    const double *previous[MAX_OVERSAMPLE + 1];
+    for (long factor = 1; factor <= MAX_OVERSAMPLE; factor++) {
+        previous[factor] = cache->tune_table[factor];
+        cache->filter_sr[factor] = samplerate * factor;
+        cache->filter_sr_inv[factor] = x->sr_inv / factor;
+        cache->tune_table[factor] = ssm2044_tune_table_for_rate(samplerate * factor);
+        cache->tune_index_scale[factor] = TUNE_TABLE_SIZE / (0.45 * samplerate * factor);
+    }
+    for (long factor = 1; factor <= MAX_OVERSAMPLE; factor++) {
+        ssm2044_tune_table_release(previous[factor]);
+    }
+    
+    // Output stages run at the host rate after decimation
+    cache->dc_coeff = 1.0 - 2.0 * PI * DC_BLOCK_FREQ / samplerate;
+    cache->bypass_step = 1.0 / (BYPASS_FADE_TIME * samplerate);
+    cache->bypass_decay = ssm2044_exp(-maxvectorsize / (BYPASS_DECAY_TIME * samplerate));
+    
+    cache->samplerate = samplerate;
+    cache->maxvectorsize = maxvectorsize;
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_release_rate_cache(t_ssm2044 *x) {
+    // Main thread only. Drops this instance's hold on the shared tables.
+    for (long factor = 1; factor <= MAX_OVERSAMPLE; factor++) {
+        ssm2044_tune_table_release(x->rate.tune_table[factor]);
+        x->rate.tune_table[factor] = NULL;
+    }
+    x->rate.samplerate = 0.0;
+}
+
+//----------------------------------------------------------------------------------------------
+
+const double *ssm2044_tune_table_for_rate(double filter_sr) {
+    // Main thread only. Returns the shared table for this rate with one more reference,
+    // deriving it on first use. Slots never used are taken first, then the first
+    // unreferenced one, so a rate that comes back soon usually still has its table.
+    t_ssm2044_tune_table *table = NULL;
+    t_ssm2044_tune_table *unused = NULL;
+    
+    for (long i = 0; i < TUNE_TABLE_SLOTS; i++) {
+        if (ssm2044_tune_tables[i].filter_sr == filter_sr) {
+            ssm2044_tune_tables[i].refs++;
+            return ssm2044_tune_tables[i].g;
+        }
+        if (!table && ssm2044_tune_tables[i].filter_sr == 0.0) {
+            table = &ssm2044_tune_tables[i];
+        }
+        if (!unused && ssm2044_tune_tables[i].refs == 0) {
+            unused = &ssm2044_tune_tables[i];
+        }
+    }
+    if (!table) {
+        table = unused;
+    }
+    if (!table) {
+        return NULL;    // Every slot is held: instances at this rate use the tan path
+    }
+    
+    // The linearized loop -k * G(z)^4 * z^-1 with G(z) = g / (1 - (1-g) z^-1) oscillates
+    // where each stage contributes (pi - w) / 4 of phase. Solving that for a = 1 - g:
+    //   a = T / (sin w + T cos w),  T = tan((pi - w) / 4)
+    for (long i = 0; i <= TUNE_TABLE_SIZE; i++) {
+        double w = 2.0 * PI * 0.45 * i / TUNE_TABLE_SIZE;
+        double t = ssm2044_tan((PI - w) * 0.25);
+        double g = 1.0 - t / (ssm2044_sin(w) + t * ssm2044_cos(w));
+        table->g[i] = CLAMP(g, 0.0, 0.99);
+    }
+    table->filter_sr = filter_sr;
+    table->refs = 1;
+    return table->g;
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_tune_table_release(const double *g) {
+    // Main thread only. The table keeps its rate, and is rebuilt only when another rate
+    // needs the slot.
+    for (long i = 0; g && i < TUNE_TABLE_SLOTS; i++) {
+        if (ssm2044_tune_tables[i].g == g && ssm2044_tune_tables[i].refs > 0) {
+            ssm2044_tune_tables[i].refs--;
+            return;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------
+
+// Transcendentals for the shared tables and per-block constants. Built from +, -, *, / in a
+// fixed order plus floor/frexp/ldexp, which are exact everywhere, so the tables hold the same
+// bits whichever libm or CPU-dispatched variant of it the host has. A few ulp from libm over
+// the arguments used here; never called per sample.
+
+#define SSM2044_LN2_HI 6.93147180369123816490e-01   // ln 2 split so n * hi is exact
+#define SSM2044_LN2_LO 1.90821492927058770002e-10
+#define SSM2044_PIO2_HI 1.57079632673412561417e+00  // pi / 2 split the same way
+#define SSM2044_PIO2_LO 6.07710050650619224932e-11
+
+double ssm2044_exp(double v) {
+    // v = n ln2 + r with |r| <= ln2 / 2, then the Taylor series of e^r to r^13
+    if (v > 709.0) {
+        return HUGE_VAL;
+    }
+    if (v < -745.0) {
+        return 0.0;
+    }
+    double n = floor(v * 1.44269504088896340736 + 0.5);
+    double r = (v - n * SSM2044_LN2_HI) - n * SSM2044_LN2_LO;
+    double p = 1.0;
+    for (long k = 13; k >= 1; k--) {
+        p = 1.0 + p * r / k;
+    }
+    return ldexp(p, (int)n);
+}
+
+//----------------------------------------------------------------------------------------------
+
+double ssm2044_log(double v) {
+    // v = m 2^e with m in [sqrt(1/2), sqrt(2)), log m = 2 atanh(s), s = (m - 1) / (m + 1),
+    // |s| < 0.172, series to s^23
+    if (v <= 0.0) {
+        return -HUGE_VAL;
+    }
+    int e;
+    double m = frexp(v, &e);
+    if (m < 0.70710678118654752440) {
+        m *= 2.0;
+        e--;
+    }
+    double s = (m - 1.0) / (m + 1.0);
+    double s2 = s * s;
+    double p = 0.0;
+    for (long k = 11; k >= 1; k--) {
+        p = (p + 1.0 / (2 * k + 1)) * s2;
+    }
+    return (e * SSM2044_LN2_HI + 2.0 * (s + s * p)) + e * SSM2044_LN2_LO;
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_sincos(double v, double *sine, double *cosine) {
+    // Quarter turns off to |r| <= pi/4, then the Taylor series to r^19 (sin) and r^18 (cos)
+    double n = floor(v * 0.63661977236758134308 + 0.5);
+    double r = (v - n * SSM2044_PIO2_HI) - n * SSM2044_PIO2_LO;
+    double r2 = r * r;
+    double s = 1.0;
+    double c = 1.0;
+    for (long k = 9; k >= 1; k--) {
+        s = 1.0 - s * r2 / ((2 * k) * (2 * k + 1));
+        c = 1.0 - c * r2 / ((2 * k - 1) * (2 * k));
+    }
+    s *= r;
+    
+    switch (((long)n % 4 + 4) % 4) {
+        case 0:  *sine = s;  *cosine = c;  break;
+        case 1:  *sine = c;  *cosine = -s; break;
+        case 2:  *sine = -s; *cosine = -c; break;
+        default: *sine = -c; *cosine = s;  break;
+    }
+}
+
+//----------------------------------------------------------------------------------------------
+
+double ssm2044_sin(double v) {
+    double s, c;
+    ssm2044_sincos(v, &s, &c);
+    return s;
+}
+
+//----------------------------------------------------------------------------------------------
+
+double ssm2044_cos(double v) {
+    double s, c;
+    ssm2044_sincos(v, &s, &c);
+    return c;
+}
+
+//----------------------------------------------------------------------------------------------
+
+double ssm2044_tan(double v) {
+    double s, c;
+    ssm2044_sincos(v, &s, &c);
+    return s / c;
+}
+
+//----------------------------------------------------------------------------------------------
+
+double ssm2044_tanh(double v) {
+    // From e^-2|v|, which stays in (0, 1] and can't overflow
+    double t = ssm2044_exp(-2.0 * fabs(v));
+    double y = (1.0 - t) / (1.0 + t);
+    return (v < 0.0) ? -y : y;
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_prepare_shared_tables(void) {
+    // dsp64 runs on the main thread, so a plain flag is enough to build once per class
+    if (ssm2044_tables_ready) {
+        return;
+    }
+    ssm2044_build_decimator_kernels();
+    ssm2044_build_morph_table();
+    ssm2044_build_saturation_table();
+    ssm2044_build_tanh_table();
+    ssm2044_build_dk_table();
+    ssm2044_build_cv_tables();
+    ssm2044_tables_ready = 1;
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_build_saturation_table(void) {
+    // The README's asymmetric curve, sampled once: tanh(u) + 0.05 * tanh(u/2)^2
+    for (long i = 0; i <= SATURATION_TABLE_SIZE; i++) {
+        double u = SATURATION_TABLE_RANGE * (2.0 * i / SATURATION_TABLE_SIZE - 1.0);
+        double even = ssm2044_tanh(u * 0.5);
+        ssm2044_saturation_table[i] = ssm2044_tanh(u) + 0.05 * even * even;
+    }
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_build_tanh_table(void) {
+    for (long i = 0; i <= TANH_TABLE_SIZE; i++) {
+        ssm2044_tanh_table[i][0] = ssm2044_tanh(TANH_TABLE_RANGE * (2.0 * i / TANH_TABLE_SIZE - 1.0));
+    }
+    for (long i = 0; i < TANH_TABLE_SIZE; i++) {
+        ssm2044_tanh_table[i][1] = ssm2044_tanh_table[i + 1][0] - ssm2044_tanh_table[i][0];
+    }
+    ssm2044_tanh_table[TANH_TABLE_SIZE][1] = 0.0;
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_build_cv_tables(void) {
+    // Expand each curve's breakpoints exponentially (linear in log frequency), so the dense
+    // table is exact 1 V/oct between points and linear interpolation of it stays within a cent
+    for (long curve = 0; curve < CV_CURVES - 1; curve++) {
+        const double *points = ssm2044_cv_breakpoints[curve];
+        for (long i = 0; i <= CV_TABLE_SIZE; i++) {
+            double volts = CV_TABLE_VOLTS * i / CV_TABLE_SIZE;
+            long segment = (long)volts;
+            if (segment >= CV_BREAKPOINTS - 1) {
+                segment = CV_BREAKPOINTS - 2;
+            }
+            double frac = volts - segment;
+            ssm2044_cv_tables[curve][i] = points[segment]
+                * ssm2044_exp(frac * ssm2044_log(points[segment + 1] / points[segment]));
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_build_dk_table(void) {
+    // Continuous model, w = wc * T/2 prewarped:  dx/dt = wc * (S x + e1 * ota). Stage 1 is a pure
+    // integrator of the OTA current (its own voltage is inside the OTA input), stages 2-4 are
+    // linear followers: S = diag(0, -1, -1, -1) + subdiagonal(1).
+    // Trapezoidal rule: M = (I - w S)^-1, A = M (I + w S), c = w M e1.
+    for (long n = 0; n <= DK_TABLE_SIZE; n++) {
+        double w = ssm2044_tan(PI * 0.45 * n / DK_TABLE_SIZE);
+        double lhs[4][4] = { { 0.0 } };
+        double rhs[4][4] = { { 0.0 } };
+        for (long i = 0; i < 4; i++) {
+            double diagonal = (i == 0) ? 0.0 : -w;
+            lhs[i][i] = 1.0 - diagonal;
+            rhs[i][i] = 1.0 + diagonal;
+            if (i > 0) {
+                lhs[i][i - 1] = -w;
+                rhs[i][i - 1] = w;
+            }
+        }
+        
+        // M = lhs^-1 by forward substitution (lhs is lower bidiagonal)
+        double mat[4][4] = { { 0.0 } };
+        for (long j = 0; j < 4; j++) {
+            mat[j][j] = 1.0 / lhs[j][j];
+            for (long i = j + 1; i < 4; i++) {
+                mat[i][j] = -lhs[i][i - 1] * mat[i - 1][j] / lhs[i][i];
+            }
+        }
+        
+        t_ssm2044_dk_matrices *entry = &ssm2044_dk_table[n];
+        for (long i = 0; i < 4; i++) {
+            for (long j = 0; j < 4; j++) {
+                double sum = 0.0;
+                for (long l = 0; l < 4; l++) {
+                    sum += mat[i][l] * rhs[l][j];
+                }
+                entry->a[i][j] = sum;
+            }
+            entry->c[i] = w * mat[i][0];
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_build_morph_table(void) {
+    // Keyframe responses as {stage input, s1, s2, s3, s4} weights
+    static const double keyframes[4][MORPH_WEIGHTS] = {
+        { 0.0,  0.0,  0.0, 0.0, 1.0 },  // LP24
+        { 0.0,  0.0,  1.0, 0.0, 0.0 },  // LP12
+        { 0.0,  2.0, -2.0, 0.0, 0.0 },  // BP (matches the BP tap)
+        { 1.0, -2.0,  1.0, 0.0, 0.0 }   // HP (matches the HP tap)
+    };
+    
+    for (long row = 0; row <= MORPH_TABLE_SIZE; row++) {
+        double position = 3.0 * row / MORPH_TABLE_SIZE;
+        long segment = (long)position;
+        if (segment > 2) {
+            segment = 2;
+        }
+        double frac = position - segment;
+        
+        for (long i = 0; i < MORPH_WEIGHTS; i++) {
+            ssm2044_morph_table[row][i] = keyframes[segment][i]
+                + frac * (keyframes[segment + 1][i] - keyframes[segment][i]);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_build_decimator_kernels(void) {
+    // Blackman-windowed sinc low-pass at 0.9 * the base-rate Nyquist, unity DC gain
+    for (long factor = 2; factor <= MAX_OVERSAMPLE; factor++) {
+        long taps = factor * DECIMATOR_TAPS_PER_FACTOR;
+        double *kernel = ssm2044_decimator_kernels[factor];
+        double center = (taps - 1) * 0.5;
+        double fc = 0.45 / factor;     // Normalized to the oversampled rate
+        double sum = 0.0;
+        
+        for (long i = 0; i < taps; i++) {
+            double t = i - center;
+            double sinc = (t == 0.0) ? 2.0 * fc : ssm2044_sin(2.0 * PI * fc * t) / (PI * t);
+            double window = 0.42 - 0.5 * ssm2044_cos(2.0 * PI * i / (taps - 1))
+                          + 0.08 * ssm2044_cos(4.0 * PI * i / (taps - 1));
+            kernel[i] = sinc * window;
+            sum += kernel[i];
+        }
+        for (long i = 0; i < taps; i++) {
+            kernel[i] /= sum;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_decimator_reset(t_ssm2044_decimator *d) {
+    memset(d->history, 0, sizeof(d->history));
+    d->position = 0;
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_decimator_prime(t_ssm2044_decimator *d, double value) {
+    // History as if the output had been holding `value`
+    for (long i = 0; i < 2 * MAX_DECIMATOR_TAPS; i++) {
+        d->history[i] = value;
+    }
+}
+
+//----------------------------------------------------------------------------------------------
+
+double ssm2044_decimator_push(t_ssm2044_decimator *d, const double *samples, long factor) {
+    // Push one base-rate frame of oversampled output and return the decimated sample
+    long taps = factor * DECIMATOR_TAPS_PER_FACTOR;
+    const double *kernel = ssm2044_decimator_kernels[factor];
+    
+    for (long j = 0; j < factor; j++) {
+        d->history[d->position] = samples[j];
+        d->history[d->position + taps] = samples[j];
+        if (++d->position >= taps) {
+            d->position = 0;
+        }
+    }
+    
+    const double *h = d->history + d->position;   // Oldest to newest
+    double acc = 0.0;
+    for (long i = 0; i < taps; i++) {
+        acc += kernel[i] * h[i];
+    }
+    return acc;
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_scratch_reserve(long maxvectorsize) {
+    // Main thread only (dsp64). Slots only ever grow, and each one is swapped while the main
+    // thread holds it, so no block is left reading a freed buffer. A block holds a slot for
+    // one perform call, so the wait for a busy one is short.
+    for (long i = 0; i < SCRATCH_SLOTS; i++) {
+        if (ssm2044_scratch_frames[i] >= maxvectorsize) {
+            continue;
+        }
+        double *grown = (double *)sysmem_newptr(sizeof(double) * maxvectorsize * SCRATCH_ROWS);
+        if (!grown) {
+            post("ssm2044~: could not allocate oversampling scratch");
+            return;     // Retried by the next dsp64; blocks that don't fit run without scratch
+        }
+        while (!ATOMIC_COMPARE_SWAP32(0, 1, &ssm2044_scratch_busy[i])) {
+            systhread_sleep(0);
+        }
+        double *old = ssm2044_scratch_pool[i];
+        ssm2044_scratch_pool[i] = grown;
+        ssm2044_scratch_frames[i] = maxvectorsize;
+        ssm2044_scratch_release(i);
+        if (old) {
+            sysmem_freeptr(old);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------
+
+long ssm2044_scratch_acquire(long sampleframes) {
+    // First free slot big enough for the block, or -1 when every slot is busy (more
+    // blocks running at once than SCRATCH_SLOTS) or none fits the vector
+    for (long i = 0; i < SCRATCH_SLOTS; i++) {
+        if (!ssm2044_scratch_busy[i] && ATOMIC_COMPARE_SWAP32(0, 1, &ssm2044_scratch_busy[i])) {
+            if (ssm2044_scratch_frames[i] >= sampleframes) {
+                return i;
+            }
+            ssm2044_scratch_release(i);
+        }
+    }
+    return -1;
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_scratch_release(long slot) {
+    // The compare-and-swap is also the barrier that publishes the block's last writes
+    ATOMIC_COMPARE_SWAP32(1, 0, &ssm2044_scratch_busy[slot]);
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_scratch_warning(t_ssm2044 *x) {
+    // Once per instance: the output is unchanged, only the block pre-passes are lost
+    object_warn((t_object *)x, "no oversampling scratch free, conditioning one frame at a time (slower)");
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_float(t_ssm2044 *x, double f) {
+    // lores~ pattern: proxy_getinlet works on signal inlets for float routing
+    long inlet = proxy_getinlet((t_object *)x);
+    
+    switch (inlet) {
+        case 1: // Cutoff frequency inlet (Hz, or volts with @cvcurve)
+            x->cutoff_float = CLAMP(f, 0.0, 20000.0);
+            break;
+        case 2: // Resonance inlet
+            x->resonance_float = CLAMP(f, 0.0, MAX_RESONANCE);
+            break;
+        case 3: // Input gain inlet
+            x->gain_float = CLAMP(f, 0.0, 4.0);
+            break;
+        case 4: // Response morph inlet
+            x->morph_float = CLAMP(f, 0.0, 1.0);
+            break;
+        case 5: // Linear FM inlet (Hz deviation)
+            x->fm_float = CLAMP(f, -20000.0, 20000.0);
+            break;
+    }
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_int(t_ssm2044 *x, long n) {
+    // lores~ pattern: proxy_getinlet works on signal inlets for int routing
+    long inlet = proxy_getinlet((t_object *)x);
+    
+    switch (inlet) {
+        case 1: // Cutoff frequency inlet - convert int to float
+            x->cutoff_float = CLAMP((double)n, 0.0, 20000.0);
+            break;
+        case 2: // Resonance inlet - convert int to float
+            x->resonance_float = CLAMP((double)n, 0.0, MAX_RESONANCE);
+            break;
+        case 3: // Input gain inlet - convert int to float
+            x->gain_float = CLAMP((double)n, 0.0, 4.0);
+            break;
+        case 4: // Response morph inlet - convert int to float
+            x->morph_float = CLAMP((double)n, 0.0, 1.0);
+            break;
+        case 5: // Linear FM inlet - convert int to float
+            x->fm_float = CLAMP((double)n, -20000.0, 20000.0);
+            break;
+    }
+}
+
+//----------------------------------------------------------------------------------------------
+
+void ssm2044_assist(t_ssm2044 *x, void *b, long m, long a, char *s) {
+    if (m == ASSIST_INLET) {
+        switch (a) {
+            case 0:
+                sprintf(s, "(signal) Audio input");
+                break;
             case 1:
-                sprintf(s, "(signal/float) Cutoff frequency (20-20000 Hz)");
+                sprintf(s, "(signal/float) Cutoff frequency (20-20000 Hz, or 0-10 V with @cvcurve)");
                 break;
             case 2:
                 sprintf(s, "(signal/float) Resonance (0-4, self-osc >3.5)");
@@ -394,8 +3203,33 @@ void ssm2044_assist(t_ssm2044 *x, void *b, long m, long a, char *s) {
             case 3:
                 sprintf(s, "(signal/float) Input gain (0-4, with musical saturation)");
                 break;
+            case 4:
+                sprintf(s, "(signal/float) Response morph (0 LP24, 0.33 LP12, 0.67 BP, 1 HP)");
+                break;
+            case 5:
+                sprintf(s, "(signal/float) Linear FM (Hz added to the cutoff)");
+                break;
         }
     } else {  // ASSIST_OUTLET
-        sprintf(s, "(signal) Filtered output - SSM2044 4-pole low-pass");
+        switch (a) {
+            case 0:
+                sprintf(s, "(signal) Filtered output - SSM2044 4-pole low-pass");
+                break;
+            case TAP_LP6 + 1:
+                sprintf(s, "(signal) 1-pole low-pass tap (6 dB/oct)");
+                break;
+            case TAP_LP12 + 1:
+                sprintf(s, "(signal) 2-pole low-pass tap (12 dB/oct)");
+                break;
+            case TAP_LP18 + 1:
+                sprintf(s, "(signal) 3-pole low-pass tap (18 dB/oct)");
+                break;
+            case TAP_BP + 1:
+                sprintf(s, "(signal) Band-pass mix of stages 1-2");
+                break;
+            case TAP_HP + 1:
+                sprintf(s, "(signal) High-pass mix of input and stages 1-2");
+                break;
+        }
     }
 }
\ No newline at end of file